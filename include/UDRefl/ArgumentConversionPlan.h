@@ -0,0 +1,69 @@
+#pragma once
+
+#include "MethodPtr.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// how to pass arguments of a signature to a compatible parameter list
+	// - compiled once per (parameter list, argument signature), see ReflMngr::ResolveOverload
+	// - only the arguments that can't be passed directly have a step
+	// - Apply is a straight-line loop over the steps, no lookup
+	// - the caller provides the scratch (GetScratchSize() bytes, aligned to GetScratchAlignment())
+	// > layout: [void* args[num_args]] [temporaries]
+	//
+	class ArgumentConversionPlan {
+	public:
+		enum class StepKind : std::uint8_t {
+			CopyPointer, // T* <- T*& | T* const& | T* const&&
+			Copy,        // T <- T& | const T& | const T&&, T is trivially copyable (memcpy)
+			Construct    // T{arg} by a non-arg-copy constructor
+		};
+
+		struct Step {
+			StepKind kind;
+			std::size_t index;  // argument index
+			std::size_t offset; // offset of the temporary in the scratch
+			std::size_t size{ 0 }; // Copy
+			const MethodPtr* ctor{ nullptr }; // Construct
+			const MethodPtr* dtor{ nullptr }; // Construct, nullptr if the type has no dtor
+		};
+
+		// scratch for typical plans fits on the stack
+		static constexpr std::size_t InlineScratchSize = 256;
+
+		ArgumentConversionPlan() noexcept = default;
+		explicit ArgumentConversionPlan(std::size_t num_args) noexcept;
+
+		void AddCopyPointer(std::size_t index);
+		void AddCopy(std::size_t index, std::size_t size, std::size_t alignment);
+		void AddConstruct(std::size_t index, std::size_t size, std::size_t alignment, const MethodPtr& ctor, const MethodPtr* dtor);
+
+		// arguments can be passed directly
+		bool IsPassThrough() const noexcept { return steps.empty(); }
+
+		std::span<const Step> GetSteps() const noexcept { return steps; }
+
+		std::size_t GetScratchSize() const noexcept { return scratch_size; }
+		std::size_t GetScratchAlignment() const noexcept { return scratch_alignment; }
+		bool FitsInline() const noexcept {
+			return scratch_size <= InlineScratchSize && scratch_alignment <= alignof(std::max_align_t);
+		}
+
+		// converted arguments are stored in the scratch
+		ArgsBuffer Apply(void* scratch, ArgsBuffer args_buffer) const;
+
+		// destruct the temporaries constructed by Apply
+		void Release(void* scratch) const noexcept;
+
+	private:
+		std::size_t Allocate(std::size_t size, std::size_t alignment) noexcept;
+
+		std::vector<Step> steps;
+		std::size_t num_args{ 0 };
+		std::size_t scratch_size{ 0 };
+		std::size_t scratch_alignment{ alignof(void*) };
+	};
+}
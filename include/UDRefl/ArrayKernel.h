@@ -0,0 +1,21 @@
+#pragma once
+
+#include "IDRegistry.h"
+
+namespace Ubpa::UDRefl {
+	// out[i] = lhs[i] op rhs[i], i in [0, count)
+	// - out may be lhs (op=) or rhs
+	using ArrayKernel = void(*)(void* out, const void* lhs, const void* rhs, std::size_t count) noexcept;
+
+	//
+	// element-wise kernels of the arithmetic meta operators
+	// - op    : operator_add/sub/mul/div, operator_assign_add/sub/mul/div (out = lhs)
+	// - typeID: std::[u]int{8|16|32|64}_t, float, double
+	// - no promotion, results are of typeID (narrow integers wrap as with op=)
+	// - plain loops the compiler vectorizes (SSE2 on x86-64, NEON on aarch64),
+	//   on x86-64, the AVX2 build of the loops is selected at the first call if the CPU supports it
+	//   (cpuid, GCC/Clang/MSVC)
+	// - nullptr if no kernel for (op, typeID)
+	//
+	ArrayKernel FindArrayKernel(StrID op, TypeID typeID) noexcept;
+}
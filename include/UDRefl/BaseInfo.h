@@ -2,21 +2,33 @@
 
 #include "Util.h"
 
+#include <optional>
+
 namespace Ubpa::UDRefl {
 	class BaseInfo {
 	public:
-		BaseInfo(InheritCastFunctions funcs, bool is_polymorphic = false, bool is_virtual = false) :
+		// offset: base = derived + offset, std::nullopt if the cast isn't a constant offset
+		// (virtual base, or custom funcs), then the cast functions are always called
+		BaseInfo(InheritCastFunctions funcs, bool is_polymorphic = false, bool is_virtual = false, std::optional<std::size_t> offset = std::nullopt) :
 			is_polymorphic{ is_polymorphic },
 			is_virtual{ is_virtual },
+			offset{ offset },
 			funcs{ std::move(funcs) }
 		{
 			assert(this->funcs.static_derived_to_base);
 			assert((is_virtual && !this->funcs.static_base_to_derived) || (!is_virtual && this->funcs.static_base_to_derived));
 			assert((is_polymorphic&& this->funcs.dynamic_base_to_derived) || (!is_polymorphic && !this->funcs.dynamic_base_to_derived));
+			assert(!is_virtual || !offset);
 		}
 
 		bool IsVirtual() const noexcept { return is_virtual; }
-		bool IsPolymorphic() const noexcept { return is_virtual; }
+		bool IsPolymorphic() const noexcept { return is_polymorphic; }
+
+		bool HasOffset() const noexcept { return offset.has_value(); }
+
+		// require HasOffset()
+		// base = derived + offset
+		std::size_t GetOffset() const noexcept { assert(HasOffset()); return *offset; }
 
 		void* StaticCast_DerivedToBase(void* ptr) const noexcept {
 			return const_cast<void*>(funcs.static_derived_to_base(ptr));
@@ -49,6 +61,7 @@ namespace Ubpa::UDRefl {
 	private:
 		bool is_polymorphic;
 		bool is_virtual;
+		std::optional<std::size_t> offset;
 		InheritCastFunctions funcs;
 	};
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "BaseInfo.h"
+#include "InsertOnlyHashMap.h"
+
+#include <span>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	// derived to base casts from a type to one of its bases (the first path depth-first)
+	// - base = derived + offset, then the casts of <unfolded_path>
+	struct CastPath {
+		// the base is reachable
+		bool valid{ false };
+		// sum of the bases' offsets before the first base without one (BaseInfo::HasOffset)
+		std::size_t offset{ 0 };
+		// derived to base casts from the first base without an offset on, empty if all have one
+		std::vector<const BaseInfo*> unfolded_path;
+		// all the derived to base casts, for dynamic casts
+		std::vector<const BaseInfo*> path;
+
+		// sums the offsets of the bases before the first one without an offset, returns their number
+		static std::size_t FoldOffsetPrefix(std::span<const BaseInfo* const> path, std::size_t& offset) noexcept {
+			std::size_t n = 0;
+			for (; n < path.size() && path[n]->HasOffset(); ++n)
+				offset += path[n]->GetOffset();
+			return n;
+		}
+
+		// a valid path from its derived to base casts
+		static CastPath FromPath(std::vector<const BaseInfo*> path) {
+			CastPath rst;
+			rst.valid = true;
+			const std::size_t n = FoldOffsetPrefix(path, rst.offset);
+			rst.unfolded_path.assign(path.begin() + n, path.end());
+			rst.path = std::move(path);
+			return rst;
+		}
+
+		explicit operator bool() const noexcept { return valid; }
+
+		const void* DerivedToBase(const void* ptr) const noexcept {
+			assert(valid);
+			ptr = static_cast<const std::uint8_t*>(ptr) + offset;
+			for (const BaseInfo* baseinfo : unfolded_path)
+				ptr = baseinfo->StaticCast_DerivedToBase(ptr);
+			return ptr;
+		}
+
+		// nullptr if a virtual base is on the path
+		const void* BaseToDerived(const void* ptr) const noexcept {
+			assert(valid);
+			for (auto iter = unfolded_path.rbegin(); ptr && iter != unfolded_path.rend(); ++iter)
+				ptr = (*iter)->StaticCast_BaseToDerived(ptr);
+			return ptr ? static_cast<const std::uint8_t*>(ptr) - offset : nullptr;
+		}
+
+		// checked by each base's dynamic cast, nullptr if the object isn't a derived one
+		// or a base on the path isn't polymorphic
+		const void* DynamicBaseToDerived(const void* ptr) const noexcept {
+			assert(valid);
+			for (auto iter = path.rbegin(); ptr && iter != path.rend(); ++iter)
+				ptr = (*iter)->DynamicCast_BaseToDerived(ptr);
+			return ptr;
+		}
+	};
+
+	//
+	// memoized cast paths, keyed by (derivedID, baseID)
+	// - lock-free Find, concurrent Insert (InsertOnlyHashMap), the paths are stable until Clear()
+	// - pointers refer to the nodes of ReflMngr::typeinfos,
+	//   so ReflMngr clears it when bases are added
+	// - Clear() must not run concurrently with Find
+	//
+	class CastPathCache {
+	public:
+		// nullptr if not cached
+		const CastPath* Find(TypeID derivedID, TypeID baseID) const noexcept { return paths.Find(Key{ derivedID, baseID }); }
+
+		// if the key is cached, the old path is kept
+		const CastPath& Insert(TypeID derivedID, TypeID baseID, CastPath path) {
+			return paths.Insert(Key{ derivedID, baseID }, std::move(path));
+		}
+
+		void Clear() noexcept { paths.Clear(); }
+
+		std::size_t Size() const noexcept { return paths.Size(); }
+
+	private:
+		struct Key {
+			TypeID derivedID;
+			TypeID baseID;
+
+			friend bool operator==(const Key&, const Key&) noexcept = default;
+		};
+
+		struct KeyHash {
+			std::size_t operator()(const Key& key) const noexcept {
+				return key.derivedID.GetValue() ^ (key.baseID.GetValue() + 0x9e3779b97f4a7c15ull + (key.derivedID.GetValue() << 6));
+			}
+		};
+
+		InsertOnlyHashMap<Key, CastPath, KeyHash> paths;
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// epoch-based reclamation for data read without locks
+	// - a reader pins the current epoch with a ReadGuard (reentrant, a cached slot per thread)
+	// - a writer unpublishes an object, then Retire()s it
+	// - a retired object is released once no reader pinned before its retirement is left
+	// - a thread must not outlive the domain it has read
+	//
+	class EpochDomain {
+		struct Slot;
+	public:
+		class ReadGuard {
+		public:
+			explicit ReadGuard(const EpochDomain& domain);
+			~ReadGuard();
+
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+
+		private:
+			Slot* slot;
+			// not cached by the thread, given back when the guard ends
+			bool owned;
+		};
+
+		EpochDomain() = default;
+		// releases the retired objects, no reader may be left
+		~EpochDomain();
+
+		EpochDomain(const EpochDomain&) = delete;
+		EpochDomain& operator=(const EpochDomain&) = delete;
+
+		// object must be unreachable for the readers entering from now on
+		void Retire(std::shared_ptr<const void> object);
+
+		// release the retired objects no reader can see, never blocks on readers
+		void Collect();
+
+		// wait for the readers which may see a retired object, then release all
+		// - the calling thread must not hold a ReadGuard of this domain
+		void Synchronize();
+
+		std::size_t NumRetired() const;
+
+	private:
+		static constexpr std::uint64_t Idle = UINT64_MAX;
+
+		struct alignas(64) Slot {
+			std::atomic<std::uint64_t> epoch{ Idle };
+			std::atomic<bool> in_use{ false };
+			std::size_t depth{ 0 }; // owner thread only
+			Slot* next{ nullptr };
+		};
+
+		struct Retired {
+			std::uint64_t epoch;
+			std::shared_ptr<const void> object;
+		};
+
+		// the calling thread's slot
+		Slot* AcquireSlot(bool& owned) const;
+		std::uint64_t MinPinnedEpoch() const noexcept;
+
+		// push-only, a slot is reused after its thread exits
+		mutable std::atomic<Slot*> slots{ nullptr };
+		std::atomic<std::uint64_t> global_epoch{ 0 };
+
+		mutable std::mutex retired_mutex;
+		std::vector<Retired> retired;
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <functional>
+
+namespace Ubpa::UDRefl {
+	// runs tasks asynchronously, e.g. on a thread pool or an event loop
+	class Executor {
+	public:
+		virtual ~Executor() = default;
+
+		// task must not throw
+		virtual void Execute(std::function<void()> task) = 0;
+	};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BaseInfo.h"
+#include "FieldInfo.h"
+
+namespace Ubpa::UDRefl {
+	//
+	// pre-resolved field, generated by ReflMngr::ResolveField
+	// - RVar/RWVar/Get/Set skip the name lookup and the base recursion
+	// - bases with an offset are folded into a constant one, the others are casted
+	// - obj must be of GetTypeID() (not a base or a derived type)
+	// - valid until ReflMngr::Clear()
+	//
+	class FieldHandle {
+	public:
+		FieldHandle() noexcept = default;
+		FieldHandle(TypeID typeID, const FieldInfo& fieldinfo, std::size_t offset, std::vector<const BaseInfo*> path);
+
+		TypeID GetTypeID() const noexcept { return typeID; }
+
+		bool Valid() const noexcept { return fieldptr != nullptr; }
+		explicit operator bool() const noexcept { return Valid(); }
+
+		const FieldPtr& GetFieldPtr() const noexcept { assert(Valid()); return *fieldptr; }
+		TypeID GetValueID() const noexcept { return GetFieldPtr().GetValueID(); }
+
+		// all
+		ConstObjectPtr RVar(const void* obj) const;
+		// variable, nullptr for const field
+		ObjectPtr RWVar(void* obj) const;
+
+		// T must be the value type
+		template<typename T>
+		const T& Get(const void* obj) const {
+			assert(GetValueID() == TypeID_of<T>);
+			return *reinterpret_cast<const T*>(RVar(obj).GetPtr());
+		}
+
+		// false if T isn't the value type or the field is const
+		template<typename T>
+		bool Set(void* obj, T&& value) const {
+			using Value = std::remove_cv_t<std::remove_reference_t<T>>;
+			if (GetValueID() != TypeID_of<Value>)
+				return false;
+			auto ptr = RWVar(obj);
+			if (!ptr.GetPtr())
+				return false;
+			*reinterpret_cast<Value*>(ptr.GetPtr()) = std::forward<T>(value);
+			return true;
+		}
+
+	private:
+		const void* StaticCast_DerivedToFieldType(const void* obj) const noexcept;
+
+		TypeID typeID;
+		FieldPtr* fieldptr{ nullptr };
+		std::size_t offset{ 0 };
+		// casts from the first base without an offset on
+		std::vector<const BaseInfo*> path;
+	};
+}
@@ -2,7 +2,6 @@
 
 #include "Object.h"
 
-#include <variant>
 #include <array>
 
 namespace Ubpa::UDRefl {
@@ -15,19 +14,22 @@ namespace Ubpa::UDRefl {
 		static constexpr size_t BufferSize = std::max(sizeof(Offsetor), sizeof(SharedBuffer)); // maybe 64
 		using Buffer = std::aligned_storage_t<BufferSize>;
 		static_assert(sizeof(Buffer) == BufferSize);
-		using Data = 
-			std::variant<
-				size_t,             // forward_offset_value 0 BASIC_VARIABLE
-				size_t,             // forward_offset_value 1 BASIC_CONST
-				Offsetor,           // offsetor             2 VIRTUAL_VARIABLE
-				Offsetor,           // offsetor             3 VIRTUAL_CONST
-				void*,              // static_obj           4 STATIC_VARIABLE
-				const void*,        // static_const_obj     5 STATIC_CONST
-				SharedBuffer,       // dynamic_obj          6 DYNAMIC_SHARED_VARIABLE
-				SharedConstBuffer,  // dynamic_obj          7 DYNAMIC_SHARED_CONST
-				Buffer,             // dynamic_obj          8 DYNAMIC_BUFFER_VARIABLE
-				const Buffer        // dynamic_obj          9 DYNAMIC_BUFFER_CONST
-			>;
+
+		// compact tagged layout
+		// - inline word: forward offset value | offset function | static object
+		// - out of line (storage): dynamic object | dynamic buffer | offset function's context
+		enum class Kind : std::uint8_t {
+			BasicVariable,         // forward_offset_value
+			BasicConst,            // forward_offset_value
+			VirtualVariable,       // offsetor + storage (context, maybe empty)
+			VirtualConst,          // offsetor + storage (context, maybe empty)
+			StaticVariable,        // static_obj
+			StaticConst,           // static_obj
+			DynamicSharedVariable, // storage
+			DynamicSharedConst,    // storage
+			DynamicBufferVariable, // storage (Buffer)
+			DynamicBufferConst     // storage (Buffer)
+		};
 
 		template<typename T>
 		static constexpr bool IsBufferable() noexcept {
@@ -52,52 +54,46 @@ namespace Ubpa::UDRefl {
 
 		constexpr FieldPtr(TypeID valueID, size_t forward_offset_value, std::true_type is_const) noexcept :
 			valueID{ valueID },
-			data{ std::in_place_index_t<1>{}, forward_offset_value }
+			kind{ Kind::BasicConst },
+			forward_offset_value{ forward_offset_value }
 		{ assert(valueID); }
 
 		constexpr FieldPtr(TypeID valueID, size_t forward_offset_value, std::false_type is_const) noexcept :
 			valueID{ valueID },
-			data{ std::in_place_index_t<0>{}, forward_offset_value }
+			kind{ Kind::BasicVariable },
+			forward_offset_value{ forward_offset_value }
 		{ assert(valueID); }
 
 		constexpr FieldPtr(TypeID valueID, size_t forward_offset_value) noexcept
 			: FieldPtr{ valueID, forward_offset_value, std::false_type{} } {}
 
-		FieldPtr(TypeID valueID, Offsetor offsetor, bool isConst) noexcept :
-			valueID{ valueID }
-		{
-			assert(valueID && offsetor);
-
-			if (isConst)
-				data.emplace<3>(std::move(offsetor));
-			else
-				data.emplace<2>(std::move(offsetor));
-		}
-
-		FieldPtr(TypeID valueID, Offsetor offsetor, std::true_type is_const) noexcept :
+		// context: offsetor's second argument, nullptr if empty
+		FieldPtr(TypeID valueID, OffsetFunction* offsetor, SharedConstBuffer context, bool isConst) noexcept :
 			valueID{ valueID },
-			data{ std::in_place_index_t<3>{}, std::move(offsetor) }
-		{
-			assert(valueID && std::get<3>(data));
-		}
+			kind{ isConst ? Kind::VirtualConst : Kind::VirtualVariable },
+			offsetor{ offsetor },
+			storage{ std::const_pointer_cast<void>(std::move(context)) }
+		{ assert(valueID && offsetor); }
 
-		FieldPtr(TypeID valueID, Offsetor offsetor, std::false_type is_const) noexcept :
-			valueID{ valueID },
-			data{ std::in_place_index_t<2>{}, std::move(offsetor) }
-		{
-			assert(valueID && std::get<2>(data));
-		}
+		FieldPtr(TypeID valueID, OffsetFunction* offsetor, bool isConst) noexcept :
+			FieldPtr{ valueID, offsetor, nullptr, isConst } {}
 
-		FieldPtr(TypeID valueID, Offsetor offsetor) noexcept : FieldPtr{ valueID, std::move(offsetor), std::false_type{} } {}
+		// type-erased offsetor, stored out of line
+		FieldPtr(TypeID valueID, Offsetor offsetor, bool isConst);
+		FieldPtr(TypeID valueID, Offsetor offsetor, std::true_type is_const) : FieldPtr{ valueID, std::move(offsetor), true } {}
+		FieldPtr(TypeID valueID, Offsetor offsetor, std::false_type is_const) : FieldPtr{ valueID, std::move(offsetor), false } {}
+		FieldPtr(TypeID valueID, Offsetor offsetor) : FieldPtr{ valueID, std::move(offsetor), false } {}
 
 		constexpr FieldPtr(TypeID valueID, void* ptr) noexcept :
 			valueID{ valueID },
-			data{ ptr }
+			kind{ Kind::StaticVariable },
+			static_obj{ ptr }
 		{ assert(valueID && ptr); }
 
 		constexpr FieldPtr(TypeID valueID, const void* ptr) noexcept :
 			valueID{ valueID },
-			data{ ptr }
+			kind{ Kind::StaticConst },
+			static_obj{ const_cast<void*>(ptr) }
 		{ assert(valueID && ptr); }
 
 		explicit constexpr FieldPtr(ObjectPtr      static_obj) noexcept : FieldPtr{ static_obj.GetID(), static_obj.GetPtr() } {}
@@ -105,62 +101,60 @@ namespace Ubpa::UDRefl {
 
 		explicit FieldPtr(const SharedObject& obj) noexcept :
 			valueID{ obj.GetID() },
-			data{ std::in_place_index_t<6>{}, obj.GetBuffer() }
+			kind{ Kind::DynamicSharedVariable },
+			storage{ obj.GetBuffer() }
 		{ assert(obj.Valid()); }
 
 		explicit FieldPtr(SharedObject&& obj) noexcept :
 			valueID{ obj.GetID() },
-			data{ std::in_place_index_t<6>{}, std::move(obj).GetBuffer() }
-		{ assert(std::get<6>(data)); }
+			kind{ Kind::DynamicSharedVariable },
+			storage{ std::move(obj).GetBuffer() }
+		{ assert(storage); }
 
 		explicit FieldPtr(const SharedConstObject& obj) noexcept :
 			valueID{ obj.GetID() },
-			data{ std::in_place_index_t<7>{}, obj.GetBuffer() }
+			kind{ Kind::DynamicSharedConst },
+			storage{ std::const_pointer_cast<void>(obj.GetBuffer()) }
 		{ assert(obj.Valid()); }
 
 		explicit FieldPtr(SharedConstObject&& obj) noexcept :
 			valueID{ obj.GetID() },
-			data{ std::in_place_index_t<7>{}, obj.GetBuffer() }
+			kind{ Kind::DynamicSharedConst },
+			storage{ std::const_pointer_cast<void>(obj.GetBuffer()) }
 		{ assert(obj.Valid()); }
 
-		FieldPtr(TypeID valueID, const Buffer& buffer, bool isConst) noexcept;
-
-		FieldPtr(TypeID valueID, const Buffer& buffer, std::true_type isConst) noexcept :
-			valueID{ valueID },
-			data{ std::in_place_index_t<9>{}, buffer }
-		{ assert(valueID); }
-
-		FieldPtr(TypeID valueID, const Buffer& buffer, std::false_type isConst) noexcept :
-			valueID{ valueID },
-			data{ std::in_place_index_t<8>{}, buffer }
-		{ assert(valueID); }
-
-		FieldPtr(TypeID valueID, const Buffer& buffer) noexcept : FieldPtr{ valueID, buffer, std::false_type{} } {}
+		// the buffer is copied out of line
+		FieldPtr(TypeID valueID, const Buffer& buffer, bool isConst);
+		FieldPtr(TypeID valueID, const Buffer& buffer, std::true_type isConst) : FieldPtr{ valueID, buffer, true } {}
+		FieldPtr(TypeID valueID, const Buffer& buffer, std::false_type isConst) : FieldPtr{ valueID, buffer, false } {}
+		FieldPtr(TypeID valueID, const Buffer& buffer) : FieldPtr{ valueID, buffer, false } {}
 
 		constexpr TypeID GetValueID() const noexcept { return valueID; }
 
-		constexpr bool IsBasicVaraible()         const noexcept { return data.index() == 0; }
-		constexpr bool IsBasicConst()            const noexcept { return data.index() == 1; }
-		constexpr bool IsVirtualVaraible()       const noexcept { return data.index() == 2; }
-		constexpr bool IsVirtualConst()          const noexcept { return data.index() == 3; }
-		constexpr bool IsStaticVaraible()        const noexcept { return data.index() == 4; }
-		constexpr bool IsStaticConst()           const noexcept { return data.index() == 5; }
-		constexpr bool IsDynamicSharedVaraible() const noexcept { return data.index() == 6; }
-		constexpr bool IsDynamicSharedConst()    const noexcept { return data.index() == 7; }
-		constexpr bool IsDynamicBufferVaraible() const noexcept { return data.index() == 8; }
-		constexpr bool IsDynamicBufferConst()    const noexcept { return data.index() == 9; }
-
-		constexpr bool IsBasic()          const noexcept { return data.index() == 0 || data.index() == 1; }
-		constexpr bool IsVirtual()        const noexcept { return data.index() == 2 || data.index() == 3; }
-		constexpr bool IsStatic()         const noexcept { return data.index() == 4 || data.index() == 5; }
-		constexpr bool IsDynamicShared()  const noexcept { return data.index() == 6 || data.index() == 7; }
-		constexpr bool IsDyanmicBuffer()  const noexcept { return data.index() == 8 || data.index() == 9; }
-
-		constexpr bool IsConst()    const noexcept { return data.index() & 1; }
+		constexpr Kind GetKind() const noexcept { return kind; }
+
+		constexpr bool IsBasicVaraible()         const noexcept { return kind == Kind::BasicVariable; }
+		constexpr bool IsBasicConst()            const noexcept { return kind == Kind::BasicConst; }
+		constexpr bool IsVirtualVaraible()       const noexcept { return kind == Kind::VirtualVariable; }
+		constexpr bool IsVirtualConst()          const noexcept { return kind == Kind::VirtualConst; }
+		constexpr bool IsStaticVaraible()        const noexcept { return kind == Kind::StaticVariable; }
+		constexpr bool IsStaticConst()           const noexcept { return kind == Kind::StaticConst; }
+		constexpr bool IsDynamicSharedVaraible() const noexcept { return kind == Kind::DynamicSharedVariable; }
+		constexpr bool IsDynamicSharedConst()    const noexcept { return kind == Kind::DynamicSharedConst; }
+		constexpr bool IsDynamicBufferVaraible() const noexcept { return kind == Kind::DynamicBufferVariable; }
+		constexpr bool IsDynamicBufferConst()    const noexcept { return kind == Kind::DynamicBufferConst; }
+
+		constexpr bool IsBasic()          const noexcept { return IsBasicVaraible() || IsBasicConst(); }
+		constexpr bool IsVirtual()        const noexcept { return IsVirtualVaraible() || IsVirtualConst(); }
+		constexpr bool IsStatic()         const noexcept { return IsStaticVaraible() || IsStaticConst(); }
+		constexpr bool IsDynamicShared()  const noexcept { return IsDynamicSharedVaraible() || IsDynamicSharedConst(); }
+		constexpr bool IsDyanmicBuffer()  const noexcept { return IsDynamicBufferVaraible() || IsDynamicBufferConst(); }
+
+		constexpr bool IsConst()    const noexcept { return static_cast<std::uint8_t>(kind) & 1; }
 		constexpr bool IsVariable() const noexcept { return !IsConst(); }
 
-		constexpr bool IsOwned() const noexcept { return data.index() < 4; }
-		constexpr bool IsUnowned()   const noexcept { return data.index() >= 4; }
+		constexpr bool IsOwned()   const noexcept { return static_cast<std::uint8_t>(kind) < static_cast<std::uint8_t>(Kind::StaticVariable); }
+		constexpr bool IsUnowned() const noexcept { return !IsOwned(); }
 
 		// { variable | const } object
 		ConstObjectPtr RVar() const;
@@ -176,6 +170,12 @@ namespace Ubpa::UDRefl {
 
 	private:
 		TypeID valueID;
-		Data data;
+		Kind kind{ Kind::BasicVariable };
+		union {
+			size_t forward_offset_value{ 0 };
+			OffsetFunction* offsetor;
+			void* static_obj;
+		};
+		SharedBuffer storage;
 	};
 }
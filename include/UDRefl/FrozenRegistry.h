@@ -0,0 +1,72 @@
+#pragma once
+
+#include "PerfectHashTable.h"
+#include "TypeInfo.h"
+
+#include <span>
+
+namespace Ubpa::UDRefl {
+	// a method reachable from a type, self or inherited
+	struct FlatMethod {
+		const MethodInfo* methodinfo;
+		// derived to base casts from the type to the method's type, empty for self methods
+		std::span<const BaseInfo* const> path;
+	};
+
+	// a field reachable from a type, self or inherited
+	// - the field's type = forward_offset(type, offset), then the casts of <path>
+	struct FlatField {
+		const FieldInfo* fieldinfo;
+		// sum of the bases' offsets before the first base without one (BaseInfo::HasOffset)
+		std::size_t offset;
+		// derived to base casts from the first base without an offset on, empty if all have one
+		std::span<const BaseInfo* const> path;
+	};
+
+	// flat view of a TypeInfo, pointers refer to the nodes of ReflMngr::typeinfos
+	struct FrozenTypeInfo {
+		const TypeInfo* typeinfo{ nullptr };
+		// TypeInfo::pool at the build, the writers may set the TypeInfo's one meanwhile
+		ObjectPool* pool{ nullptr };
+		ObjectPool* shared_pool{ nullptr };
+		PerfectHashTable<StrID, const FieldInfo*> fieldinfos;
+		// self fields in the order of TypeInfo::fieldinfos, for iteration
+		std::span<const std::pair<StrID, const FieldInfo*>> ordered_fieldinfos;
+		// self methods in the order of TypeInfo::methodinfos, for iteration
+		std::span<const std::pair<StrID, const MethodInfo*>> ordered_methodinfos;
+		// overloads are contiguous, in the order of TypeInfo::methodinfos
+		PerfectHashTable<StrID, std::span<const MethodInfo* const>> methodinfos;
+		std::span<const std::pair<TypeID, const BaseInfo*>> baseinfos;
+		// self and inherited overloads (vtable-like), self first, then the bases depth-first
+		// - a type's overloads are contiguous and share the path
+		// - a base reachable by several paths only appears on the first one
+		PerfectHashTable<StrID, std::span<const FlatMethod>> flat_methodinfos;
+		// self and inherited fields, self first, then the bases depth-first
+		// - fields with the same name (hidden ones) are kept, the first one hides the others
+		PerfectHashTable<StrID, std::span<const FlatField>> flat_fieldinfos;
+	};
+
+	//
+	// immutable lookup tables compiled from ReflMngr::typeinfos
+	// - the nodes of typeinfos must outlive it, the maps may grow (nodes are stable)
+	// - readers never touch typeinfos, so a writer may add to it while they read
+	//
+	class FrozenRegistry {
+	public:
+		// false if a table can't be built (PerfectHashTable::Build), then it is left empty
+		bool Build(const std::unordered_map<TypeID, TypeInfo>& typeinfos);
+		void Clear() noexcept;
+
+		const FrozenTypeInfo* FindTypeInfo(TypeID typeID) const noexcept { return types.Find(typeID); }
+
+	private:
+		PerfectHashTable<TypeID, FrozenTypeInfo> types;
+		std::vector<const MethodInfo*> methods;
+		std::vector<std::pair<StrID, const FieldInfo*>> ordered_fields;
+		std::vector<std::pair<StrID, const MethodInfo*>> ordered_methods;
+		std::vector<std::pair<TypeID, const BaseInfo*>> bases;
+		std::vector<FlatMethod> flat_methods;
+		std::vector<FlatField> flat_fields;
+		std::vector<const BaseInfo*> paths;
+	};
+}
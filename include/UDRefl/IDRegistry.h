@@ -1,16 +1,25 @@
 #pragma once
 
+#include "InsertOnlyHashMap.h"
+
 #include <UTemplate/TypeID.h>
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory_resource>
+#include <shared_mutex>
 
 #ifndef NDEBUG
 #include <unordered_set>
 #endif // !NDEBUG
 
 namespace Ubpa::UDRefl {
+	//
+	// ID <-> name
+	// - lookups and registrations are thread-safe (readers-writer lock)
+	// - Clear() and the unmanaged bookkeeping must not run concurrently
+	//
 	template<typename T>
 	class IDRegistry {
 	public:
@@ -28,8 +37,18 @@ namespace Ubpa::UDRefl {
 		void Clear() noexcept;
 
 	protected:
+		// require: the unique lock of <mutex>
 		std::pmr::polymorphic_allocator<char> get_allocator() { return &resource; }
 
+		// require: the unique lock of <mutex>
+		void RegisterUnmanaged_Unlocked(T ID, std::string_view name);
+		void Register_Unlocked(T ID, std::string_view name);
+
+		// require: the shared lock of <mutex>
+		std::string_view Nameof_Unlocked(T ID) const;
+
+		mutable std::shared_mutex mutex;
+
 	private:
 		std::pmr::monotonic_buffer_resource resource;
 		std::pmr::unordered_map<T, std::string_view> id2name;
@@ -306,6 +325,31 @@ namespace Ubpa::UDRefl {
 			static constexpr TypeID t_void = Meta::t_void;
 		};
 
+		// computed from the name when the ID is registered
+		// so that the invoke and field paths only compare IDs
+		struct TypeShape {
+			enum class Reference : std::uint8_t {
+				None,
+				LValue,
+				RValue
+			};
+
+			Reference reference{ Reference::None };
+			bool is_const{ false }; // referee, e.g. &{const{T}}
+			bool is_pointer{ false };
+
+			TypeID referee; // remove_reference, T | const{T}
+			TypeID raw;     // remove_cvref, T
+			TypeID lref;    // &{T}
+			TypeID clref;   // &{const{T}}
+			TypeID rref;    // &&{T}
+			TypeID crref;   // &&{const{T}}
+
+			bool IsReference() const noexcept { return reference != Reference::None; }
+			bool IsLValueReference() const noexcept { return reference == Reference::LValue; }
+			bool IsRValueReference() const noexcept { return reference == Reference::RValue; }
+		};
+
 		TypeIDRegistry();
 
 		void   RegisterUnmanaged(TypeID ID, std::string_view name);
@@ -321,9 +365,24 @@ namespace Ubpa::UDRefl {
 		template<typename T>
 		bool IsRegistered() const;
 
+		// nullptr if ID has never been registered
+		// - lock-free, the shapes are immutable and stay until Clear()
+		//   (UnregisterUnmanaged keeps them, a shape only depends on the name)
+		const TypeShape* GetShape(TypeID ID) const noexcept;
+
+		void UnregisterUnmanaged(TypeID ID);
+		void Clear() noexcept;
+
+#ifndef NDEBUG
+		void ClearUnmanaged() noexcept;
+#endif // !NDEBUG
+
 		//
 		// Type Computation
 		/////////////////////
+		//
+		// the names are computed in the registry's resource, under the unique lock
+		//
 
 		TypeID RegisterAddLValueReference(TypeID ID);
 		TypeID RegisterAddConstLValueReference(TypeID ID);
@@ -333,6 +392,11 @@ namespace Ubpa::UDRefl {
 	private:
 		using IDRegistry<TypeID>::Register;
 		using IDRegistry<TypeID>::IsRegistered;
+
+		// require: the unique lock of <mutex>
+		void RegisterShape(TypeID ID, std::string_view name);
+
+		InsertOnlyHashMap<TypeID, TypeShape> id2shape;
 	};
 }
 
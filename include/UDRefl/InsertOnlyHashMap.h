@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// hash map for concurrent readers, entries are never erased or changed once inserted
+	// - Find is lock-free (acquire loads, linear probing), Insert serializes on a mutex
+	// - the entries are stable, a found value outlives any later Insert
+	// - a full table is copied into a twice bigger one, the old ones are kept for
+	//   the readers still probing them, until Clear()
+	// - Clear() must not run concurrently with Find
+	// - Hash and KeyEqual may be transparent, Find takes any key they accept
+	//
+	template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<>>
+	class InsertOnlyHashMap {
+	public:
+		InsertOnlyHashMap() = default;
+		InsertOnlyHashMap(const InsertOnlyHashMap&) = delete;
+		InsertOnlyHashMap& operator=(const InsertOnlyHashMap&) = delete;
+
+		// nullptr if not inserted
+		template<typename K>
+		const Value* Find(const K& key) const noexcept;
+
+		// if the key is inserted, the old value is kept
+		const Value& Insert(Key key, Value value);
+
+		void Clear() noexcept;
+
+		std::size_t Size() const noexcept { return size.load(std::memory_order_relaxed); }
+
+	private:
+		struct Entry {
+			std::size_t hash;
+			Key key;
+			Value value;
+		};
+
+		struct Table {
+			explicit Table(std::size_t capacity);
+
+			std::size_t Index(std::size_t hash) const noexcept {
+				return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> shift);
+			}
+
+			std::size_t mask;
+			unsigned shift;
+			std::unique_ptr<std::atomic<const Entry*>[]> slots;
+		};
+
+		template<typename K>
+		const Entry* FindEntry(const Table* table, std::size_t hash, const K& key) const noexcept;
+
+		// require: the lock of <mutex>
+		const Value& InsertEntry(std::unique_ptr<Entry> entry);
+
+		std::atomic<const Table*> table{ nullptr };
+		std::atomic<std::size_t> size{ 0 };
+
+		std::mutex mutex;
+		// the current table is the last one
+		std::vector<std::unique_ptr<Table>> tables;
+		std::vector<std::unique_ptr<Entry>> entries;
+	};
+}
+
+#include "details/InsertOnlyHashMap.inl"
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "MethodResolutionCache.h"
+
+namespace Ubpa::UDRefl {
+	//
+	// pre-resolved overload, generated by ReflMngr::ResolveMethod
+	// - Invoke skips the name lookup, the base recursion and the compatibility checks
+	// - arguments must be of the argTypeIDs used to resolve it
+	// - obj must be of GetTypeID() (not a base or a derived type)
+	// - valid until ReflMngr::Clear()
+	//
+	class MethodHandle {
+	public:
+		MethodHandle() noexcept = default;
+		MethodHandle(TypeID typeID, const MethodResolution& resolution);
+
+		TypeID GetTypeID() const noexcept { return typeID; }
+
+		bool Valid() const noexcept { return methodptr != nullptr; }
+		explicit operator bool() const noexcept { return Valid(); }
+
+		const MethodPtr& GetMethodPtr() const noexcept { assert(Valid()); return *methodptr; }
+		const ResultDesc& GetResultDesc() const noexcept { return GetMethodPtr().GetResultDesc(); }
+
+		// all
+		Destructor Invoke(void* obj, void* result_buffer, ArgsBuffer args_buffer) const;
+		// static and member const
+		Destructor Invoke(const void* obj, void* result_buffer, ArgsBuffer args_buffer) const;
+		// static
+		Destructor Invoke(void* result_buffer, ArgsBuffer args_buffer) const;
+
+	private:
+		const void* StaticCast_DerivedToMethodType(const void* obj) const noexcept;
+
+		TypeID typeID;
+		const MethodPtr* methodptr{ nullptr };
+		std::vector<const BaseInfo*> path;
+		ArgumentConversionPlan plan;
+	};
+}
@@ -2,12 +2,52 @@
 
 #include "Object.h"
 
-#include <vector>
-#include <variant>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 
 namespace Ubpa::UDRefl {
-	using ParamList = std::vector<TypeID>;
-	
+	// parameter types of a method
+	// - at most InlineCapacity types are stored inline, longer lists live on the heap
+	// - contiguous, converts to std::span<const TypeID>
+	class ParamList {
+	public:
+		static constexpr size_t InlineCapacity = 4;
+
+		ParamList() noexcept {}
+		ParamList(std::initializer_list<TypeID> ids) : ParamList{ std::span<const TypeID>{ ids.begin(), ids.size() } } {}
+		explicit ParamList(std::span<const TypeID> ids);
+
+		ParamList(const ParamList& rhs) : ParamList{ std::span<const TypeID>{ rhs.data(), rhs.size() } } {}
+		ParamList(ParamList&& rhs) noexcept;
+		ParamList& operator=(const ParamList& rhs);
+		ParamList& operator=(ParamList&& rhs) noexcept;
+		~ParamList() { if (!IsInline()) delete[] heap_ids; }
+
+		bool IsInline() const noexcept { return count <= InlineCapacity; }
+
+		const TypeID* data() const noexcept { return IsInline() ? inline_ids.data() : heap_ids; }
+		size_t size() const noexcept { return count; }
+		bool empty() const noexcept { return count == 0; }
+
+		const TypeID* begin() const noexcept { return data(); }
+		const TypeID* end() const noexcept { return data() + count; }
+
+		const TypeID& operator[](size_t idx) const noexcept { assert(idx < count); return data()[idx]; }
+
+		friend bool operator==(const ParamList& lhs, const ParamList& rhs) noexcept {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend bool operator!=(const ParamList& lhs, const ParamList& rhs) noexcept { return !(lhs == rhs); }
+
+	private:
+		size_t count{ 0 };
+		union {
+			std::array<TypeID, InlineCapacity> inline_ids{}; // count <= InlineCapacity
+			TypeID* heap_ids;                                // count >  InlineCapacity
+		};
+	};
+
 	class ArgsView {
 	public:
 		ArgsView(ArgsBuffer buffer, const ParamList& paramList) : buffer{ buffer }, paramList{ paramList }{}
@@ -32,46 +72,81 @@ namespace Ubpa::UDRefl {
 		using MemberConstFunction    = Destructor(const void*, void*, ArgsView);
 		using StaticFunction         = Destructor(             void*, ArgsView);
 
+		// the first argument is the stored callable
+		using MemberVariableInvoker = Destructor(void*,       void*, void*, ArgsView);
+		using MemberConstInvoker    = Destructor(void*, const void*, void*, ArgsView);
+		using StaticInvoker         = Destructor(void*,              void*, ArgsView);
+
+		//
+		// Buffer
+		///////////
+
+		static constexpr size_t CallableBufferSize = 2 * sizeof(void*);
+		using CallableBuffer = std::aligned_storage_t<CallableBufferSize>;
+
+		// compact tagged layout
+		// - function pointer
+		// - invoker + callable (inline buffer | out of line storage)
+		enum class Kind : std::uint8_t {
+			MemberVariable,         // function pointer
+			MemberConst,            // function pointer
+			Static,                 // function pointer
+			MemberVariableCallable, // invoker + callable
+			MemberConstCallable,    // invoker + callable
+			StaticCallable          // invoker + callable
+		};
+
+		template<typename Func>
+		static constexpr bool IsInlineCallable() noexcept {
+			return std::is_trivially_copyable_v<Func>
+				&& sizeof(Func) <= CallableBufferSize
+				&& alignof(Func) <= alignof(CallableBuffer);
+		}
+
+		//
+		// Constructor
+		////////////////
+
 		MethodPtr(MemberVariableFunction* func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ func },
+			kind{ Kind::MemberVariable },
+			memberVariableFunction{ func },
 			resultDesc{ std::move(resultDesc) },
 			paramList{ std::move(paramList) } { assert(func); }
 
 		MethodPtr(MemberConstFunction* func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ func },
+			kind{ Kind::MemberConst },
+			memberConstFunction{ func },
 			resultDesc{ std::move(resultDesc) },
 			paramList{ std::move(paramList) } { assert(func); }
 
 		MethodPtr(StaticFunction* func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ func },
+			kind{ Kind::Static },
+			staticFunction{ func },
 			resultDesc{ std::move(resultDesc) },
 			paramList{ std::move(paramList) } { assert(func); }
 
-		MethodPtr(std::function<MemberVariableFunction> func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ (assert(func), std::move(func)) },
-			resultDesc{ std::move(resultDesc) },
-			paramList{ std::move(paramList) } {}
+		// Func: MemberVariableFunction | MemberConstFunction | StaticFunction (e.g. lambda, std::function)
+		// - stateless (e.g. captureless lambda) : decays to a function pointer
+		// - IsInlineCallable<Func>()            : stored inline
+		// - otherwise                           : stored out of line
+		template<typename Func, std::enable_if_t<!std::is_same_v<std::decay_t<Func>, MethodPtr>
+			&& !std::is_pointer_v<std::decay_t<Func>>, int> = 0>
+		MethodPtr(Func&& func, ResultDesc resultDesc = {}, ParamList paramList = {});
 
-		MethodPtr(std::function<MemberConstFunction> func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ (assert(func), std::move(func)) },
-			resultDesc{ std::move(resultDesc) },
-			paramList{ std::move(paramList) } {}
+		constexpr Kind GetKind() const noexcept { return kind; }
 
-		MethodPtr(std::function<StaticFunction> func, ResultDesc resultDesc = {}, ParamList paramList = {}) :
-			func{ (assert(func), std::move(func)) },
-			resultDesc{ std::move(resultDesc) },
-			paramList{ std::move(paramList) } {}
-
-		bool IsMemberVariable() const noexcept { return func.index() == 0 || func.index() == 3; }
-		bool IsMemberConst   () const noexcept { return func.index() == 1 || func.index() == 4; }
-		bool IsStatic        () const noexcept { return func.index() == 2 || func.index() == 5; }
+		bool IsMemberVariable() const noexcept { return kind == Kind::MemberVariable || kind == Kind::MemberVariableCallable; }
+		bool IsMemberConst   () const noexcept { return kind == Kind::MemberConst    || kind == Kind::MemberConstCallable; }
+		bool IsStatic        () const noexcept { return kind == Kind::Static         || kind == Kind::StaticCallable; }
 
 		const ParamList&  GetParamList() const noexcept { return paramList; }
 		const ResultDesc& GetResultDesc() const noexcept { return resultDesc; }
 
+		// a stateless callable and its function pointer are not distinguishable
 		bool IsDistinguishableWith(const MethodPtr& rhs) const noexcept {
-			return func.index() != rhs.func.index() ||
-				paramList != rhs.paramList;
+			return IsMemberVariable() != rhs.IsMemberVariable()
+				|| IsMemberConst() != rhs.IsMemberConst()
+				|| paramList != rhs.paramList;
 		}
 
 		Destructor Invoke(      void* obj, void* result_buffer, ArgsBuffer args_buffer) const;
@@ -79,15 +154,25 @@ namespace Ubpa::UDRefl {
 		Destructor Invoke(                 void* result_buffer, ArgsBuffer args_buffer) const;
 
 	private:
-		std::variant<
-			MemberVariableFunction*,
-			MemberConstFunction*,
-			StaticFunction*,
-			std::function<MemberVariableFunction>,
-			std::function<MemberConstFunction>,
-			std::function<StaticFunction>
-		> func;
+		void* GetCallable() const noexcept { return storage ? storage.get() : static_cast<void*>(&callable); }
+
+		template<typename Func>
+		static constexpr Kind CallableKindOf() noexcept;
+
+		Kind kind;
+		union {
+			MemberVariableFunction* memberVariableFunction;
+			MemberConstFunction*    memberConstFunction;
+			StaticFunction*         staticFunction;
+			MemberVariableInvoker*  memberVariableInvoker;
+			MemberConstInvoker*     memberConstInvoker;
+			StaticInvoker*          staticInvoker;
+		};
+		mutable CallableBuffer callable; // inline callable
+		SharedBuffer storage;            // out of line callable
 		ResultDesc resultDesc;
 		ParamList paramList;
 	};
 }
+
+#include "details/MethodPtr.inl"
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TypeInfo.h"
+#include "ArgumentConversionPlan.h"
+#include "InsertOnlyHashMap.h"
+
+#include <span>
+
+namespace Ubpa::UDRefl {
+	// which overloads an invocation can call
+	enum class MethodSearchMode : std::uint8_t {
+		Static,   // TypeID : static
+		Const,    // ConstObjectPtr : static, member const
+		Variable  // ObjectPtr : static and member variable, then member const
+	};
+
+	// result of overload resolution
+	struct MethodResolution {
+		// nullptr if nothing is invocable
+		const MethodInfo* methodinfo{ nullptr };
+
+		// derived to base casts from the object's type to the method's type
+		std::vector<const BaseInfo*> path;
+
+		// how to pass the arguments to the method's parameters
+		ArgumentConversionPlan plan;
+
+		explicit operator bool() const noexcept { return methodinfo != nullptr; }
+	};
+
+	//
+	// memoized overload resolution, keyed by (typeID, methodID, mode, argTypeIDs)
+	// - lock-free Find, concurrent Insert (InsertOnlyHashMap), the resolutions are stable until Clear()
+	// - pointers refer to the nodes of ReflMngr::typeinfos,
+	//   so ReflMngr clears it when methods or bases are added
+	// - Clear() must not run concurrently with Find
+	//
+	class MethodResolutionCache {
+	public:
+		// nullptr if not cached
+		const MethodResolution* Find(
+			TypeID typeID,
+			StrID methodID,
+			MethodSearchMode mode,
+			std::span<const TypeID> argTypeIDs) const;
+
+		// if the key is cached, the old resolution is kept
+		const MethodResolution& Insert(
+			TypeID typeID,
+			StrID methodID,
+			MethodSearchMode mode,
+			std::span<const TypeID> argTypeIDs,
+			MethodResolution resolution);
+
+		void Clear() noexcept { resolutions.Clear(); }
+
+		std::size_t Size() const noexcept { return resolutions.Size(); }
+
+	private:
+		struct KeyView {
+			TypeID typeID;
+			StrID methodID;
+			MethodSearchMode mode;
+			std::span<const TypeID> argTypeIDs;
+		};
+
+		struct Key {
+			TypeID typeID;
+			StrID methodID;
+			MethodSearchMode mode;
+			std::vector<TypeID> argTypeIDs;
+
+			KeyView View() const noexcept { return { typeID, methodID, mode, argTypeIDs }; }
+		};
+
+		struct KeyHash {
+			using is_transparent = int;
+
+			std::size_t operator()(const KeyView& key) const noexcept;
+			std::size_t operator()(const Key& key) const noexcept { return (*this)(key.View()); }
+		};
+
+		struct KeyEqual {
+			using is_transparent = int;
+
+			static bool Equal(const KeyView& lhs, const KeyView& rhs) noexcept;
+
+			bool operator()(const Key&     lhs, const Key&     rhs) const noexcept { return Equal(lhs.View(), rhs.View()); }
+			bool operator()(const Key&     lhs, const KeyView& rhs) const noexcept { return Equal(lhs.View(), rhs); }
+			bool operator()(const KeyView& lhs, const Key&     rhs) const noexcept { return Equal(lhs, rhs.View()); }
+		};
+
+		InsertOnlyHashMap<Key, MethodResolution, KeyHash, KeyEqual> resolutions;
+	};
+}
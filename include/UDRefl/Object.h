@@ -2,6 +2,7 @@
 
 #include "Basic.h"
 #include "IDRegistry.h"
+#include "ScratchArena.h"
 
 #include <optional>
 #include <span>
@@ -112,6 +113,13 @@ namespace Ubpa::UDRefl {
 		template<typename T, typename... Args>
 		T Invoke(StrID methodID, Args&&... args) const;
 
+		// resolve and call in one step, std::nullopt if not invocable
+		template<typename T>
+		std::optional<T> TryInvokeRet(StrID methodID, std::span<const TypeID> argTypeIDs = {}, ArgsBuffer args_buffer = nullptr) const;
+
+		template<typename T, typename... Args>
+		std::optional<T> TryInvoke(StrID methodID, Args&&... args) const;
+
 		SharedObject MInvoke(
 			StrID methodID,
 			std::span<const TypeID> argTypeIDs = {},
@@ -419,6 +427,13 @@ namespace Ubpa::UDRefl {
 		template<typename T, typename... Args>
 		T Invoke(StrID methodID, Args&&... args) const;
 
+		// resolve and call in one step, std::nullopt if not invocable
+		template<typename T>
+		std::optional<T> TryInvokeRet(StrID methodID, std::span<const TypeID> argTypeIDs = {}, ArgsBuffer args_buffer = nullptr) const;
+
+		template<typename T, typename... Args>
+		std::optional<T> TryInvoke(StrID methodID, Args&&... args) const;
+
 		template<typename... Args>
 		SharedObject MInvoke(
 			StrID methodID,
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// fixed size blocks carved from slabs
+	// - each thread allocates from and frees to its own free list (no lock),
+	//   batches move through a shared list under a lock when a list runs dry or grows too long
+	// - a block may be freed by another thread than the allocating one
+	// - the slabs are given back when the pool is destroyed, all blocks must be free by then
+	// - the other threads which used the pool must have exited before it is destroyed
+	//
+	class ObjectPool final : public std::pmr::memory_resource {
+	public:
+		ObjectPool(
+			std::size_t block_size,
+			std::size_t block_alignment,
+			std::size_t blocks_per_slab,
+			std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+		~ObjectPool();
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		void* Allocate();
+		void Deallocate(void* block);
+
+		std::size_t BlockSize() const noexcept { return block_size; }
+		std::size_t BlockAlignment() const noexcept { return block_alignment; }
+		std::size_t BlocksPerSlab() const noexcept { return blocks_per_slab; }
+		std::size_t NumSlabs() const;
+
+		// block size of the size class of an object
+		static std::size_t SizeClass(std::size_t size, std::size_t alignment) noexcept;
+
+	private:
+		struct FreeBlock {
+			FreeBlock* next;
+		};
+
+		struct FreeList {
+			FreeBlock* head{ nullptr };
+			std::size_t count{ 0 };
+		};
+
+		class ThreadCache;
+
+		// the calling thread's free list, nullptr when its cache is destroyed (then the shared one is used)
+		FreeList* LocalList();
+
+		// require: central_mutex
+		void AllocateSlab();
+
+		static void* Pop(FreeList& list) noexcept;
+		static void Push(FreeList& list, void* block) noexcept;
+		// move up to <count> blocks of <from> to <to>
+		static void Transfer(FreeList& from, FreeList& to, std::size_t count) noexcept;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		const std::size_t block_size;
+		const std::size_t block_alignment;
+		const std::size_t blocks_per_slab;
+		// blocks moved between a thread's list and the shared one at once
+		const std::size_t batch_size;
+		// index of the pool's free list in the threads' caches
+		const std::size_t index;
+		std::pmr::memory_resource* upstream;
+
+		mutable std::mutex central_mutex;
+		FreeList central;
+		std::vector<void*> slabs;
+	};
+}
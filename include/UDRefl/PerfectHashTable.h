@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// immutable hash table without collisions (hash and displace)
+	// - Key: TypeID or StrID (the value is already a hash)
+	// - a lookup is one probe of the displacement array and one probe of the slots
+	// - build once, then only Find
+	//
+	template<typename Key, typename Value>
+	class PerfectHashTable {
+	public:
+		// keys must be valid
+		// - false if the keys aren't unique (e.g. colliding StrIDs), the table is left empty
+		bool Build(std::vector<std::pair<Key, Value>> items);
+		void Clear() noexcept;
+
+		const Value* Find(Key key) const noexcept;
+
+		std::size_t Size() const noexcept { return size; }
+		bool Empty() const noexcept { return size == 0; }
+
+		// iterate the occupied slots
+		template<typename Func> // void(Key, const Value&)
+		void ForEach(Func&& func) const;
+
+	private:
+		struct Slot {
+			Key key;
+			Value value;
+		};
+
+		std::size_t BucketIndex(std::uint64_t h) const noexcept;
+		std::size_t SlotIndex(std::uint64_t h, std::uint32_t displacement) const noexcept;
+
+		std::vector<std::uint32_t> displacements;
+		std::vector<Slot> slots;
+		std::size_t size{ 0 };
+		std::uint32_t bucket_shift{ 63 };
+	};
+}
+
+#include "details/PerfectHashTable.inl"
@@ -2,11 +2,27 @@
 
 #include "attrs/ContainerType.h"
 
-#include "TypeInfo.h"
+#include "ArrayKernel.h"
+#include "CastPathCache.h"
+#include "EpochDomain.h"
+#include "Executor.h"
+#include "FieldHandle.h"
+#include "FrozenRegistry.h"
+#include "MethodHandle.h"
+#include "ScratchArena.h"
+#include "Task.h"
+#include "ThreadPool.h"
+#include "TypeHierarchy.h"
+
+#include <future>
 
 namespace Ubpa::UDRefl {
 	constexpr TypeID GlobalID = TypeIDRegistry::MetaID::global;
 
+	namespace details {
+		struct CapturedCall;
+	}
+
 	class ReflMngr {
 	public:
 		static ReflMngr& Instance() noexcept {
@@ -38,7 +54,101 @@ namespace Ubpa::UDRefl {
 		// Lookup
 		///////////
 
-		bool IsRegistered(TypeID typeID) const noexcept { return typeinfos.find(typeID) != typeinfos.end(); }
+		bool IsRegistered(TypeID typeID) const noexcept;
+
+		//
+		// Freeze
+		///////////
+		//
+		// - Freeze() compiles <typeinfos> into immutable flat perfect-hash tables,
+		//   then Invoke/RVar/RWVar find types, fields and methods with one probe
+		// - frozen, lookups are lock-free and safe to run concurrently with the modifiers
+		//   > readers pin the published tables with a ReadGuard, they never touch <typeinfos>
+		//   > modifiers serialize, the outermost one rebuilds and publishes the tables,
+		//     the old ones are released once no reader pinned before can see them
+		//   > a rebuild is O(registry), so each modifier outside a WriteGuard (e.g. one AddMethod)
+		//     costs a full rebuild, take a WriteGuard to publish a batch once
+		//   > the type shapes (TypeIDRegistry::GetShape) and the per-table caches
+		//     (overload resolution, cast paths, hierarchy) are insert-only, lock-free to read
+		//   > TypeInfo/FieldInfo/MethodInfo handed out (TypeRef, GetType, ...) are the registered nodes,
+		//     they are stable, but their maps (e.g. attrs) belong to the modifiers
+		// - Freeze() returns false if the tables can't be built (PerfectHashTable::Build), then it stays
+		//   unfrozen; a modifier whose rebuild fails when frozen unfreezes
+		// - not frozen, ReflMngr is not thread-safe
+		// - Freeze/Unfreeze/Clear must not run concurrently with readers
+		// - don't touch <typeinfos> directly when frozen
+		//
+
+		bool Freeze();
+		void Unfreeze() noexcept;
+		bool IsFrozen() const noexcept { return frozen_snapshot.load(std::memory_order_acquire) != nullptr; }
+
+		// nullptr if not frozen or not registered
+		// - valid while a ReadGuard is held, or until the next modifier
+		const FrozenTypeInfo* GetFrozenTypeInfo(TypeID typeID) const noexcept;
+
+		// pins the published tables of the calling thread (reentrant)
+		// - the lookups take one, hold it to keep the results of GetFrozenTypeInfo
+		class ReadGuard {
+		public:
+			ReadGuard();
+
+		private:
+			EpochDomain::ReadGuard guard;
+		};
+
+		// serializes the modifiers (reentrant), the outermost one publishes the changes if frozen
+		// - the modifiers take one, hold it to publish a batch of them once
+		class WriteGuard {
+		public:
+			WriteGuard() : WriteGuard{ Instance() } {}
+			~WriteGuard();
+
+			WriteGuard(const WriteGuard&) = delete;
+			WriteGuard& operator=(const WriteGuard&) = delete;
+
+		private:
+			friend class ReflMngr;
+
+			// the modifiers run in ReflMngr(), before Instance() returns
+			explicit WriteGuard(ReflMngr& mngr);
+
+			// <typeinfos> changed
+			void Modified() noexcept { mngr.write_modified = true; }
+
+			ReflMngr& mngr;
+		};
+
+		//
+		// Overload Resolution
+		////////////////////////
+		//
+		// - Invoke/MInvoke/Is*Invocable memoize it by (typeID, methodID, mode, argTypeIDs)
+		// - AddMethod/AddBase clear the cache, frozen, every published table starts with an empty one
+		// - frozen, the resolution is valid while a ReadGuard is held
+		// - call ClearMethodResolutionCache() after modifying <typeinfos> directly
+		//
+
+		// typeID must not be a reference
+		const MethodResolution& ResolveOverload(
+			MethodSearchMode mode,
+			TypeID typeID,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {}) const;
+
+		void ClearMethodResolutionCache() const;
+
+		// Variable : for ObjectPtr, Const : for ConstObjectPtr, Static : for TypeID
+		// if typeID is a reference, dereference it
+		// if no method is invocable, return an invalid handle
+		MethodHandle ResolveMethod(
+			TypeID typeID,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			MethodSearchMode mode = MethodSearchMode::Variable) const;
+
+		template<typename... Args>
+		MethodHandle ResolveMethod(TypeID typeID, StrID methodID, MethodSearchMode mode = MethodSearchMode::Variable) const;
 
 		//
 		// Factory
@@ -211,7 +321,7 @@ namespace Ubpa::UDRefl {
 		// Modifier
 		/////////////
 
-		TypeID RegisterType(std::string_view name, size_t size, size_t alignment);
+		TypeID RegisterType(std::string_view name, size_t size, size_t alignment, TypeTraits traits = {});
 		StrID AddField(TypeID typeID, std::string_view name, FieldInfo fieldinfo);
 		StrID AddMethod(TypeID typeID, std::string_view name, MethodInfo methodinfo);
 		bool AddBase(TypeID derivedID, TypeID baseID, BaseInfo baseinfo);
@@ -219,7 +329,7 @@ namespace Ubpa::UDRefl {
 
 		// -- template --
 
-		// RegisterType(type_name<T>(), sizeof(T), alignof(T))
+		// RegisterType(type_name<T>(), sizeof(T), alignof(T), TypeTraits::Of<T>())
 		// AddConstructor<T>()
 		// AddConstructor<T, const T&>()
 		// AddConstructor<T, T&&>()
@@ -301,8 +411,28 @@ namespace Ubpa::UDRefl {
 		/////////
 		//
 		// - cast APIs with ObjectPtr don't support reference
+		// - static casts memoize the path by (derivedID, baseID), see ResolveCastPath
+		// - base to derived casts reject the types not derived from the object's type with IsDerivedFrom,
+		//   before any path lookup or dynamic_cast
 		//
 
+		// the first derived to base path depth-first, bases with an offset (BaseInfo::HasOffset) folded into one
+		// - AddBase clears the cache, frozen, every published table starts with an empty one
+		// - valid while a ReadGuard is held
+		// - call ClearCastPathCache() after modifying <typeinfos> directly
+		const CastPath& ResolveCastPath(TypeID derivedID, TypeID baseID) const;
+
+		void ClearCastPathCache() const;
+
+		// derivedID == baseID, or baseID is a direct, indirect or virtual base of derivedID
+		// - a bit test of the hierarchy encoding (TypeHierarchy), built lazily per type
+		// - AddBase clears the encoding, frozen, every published table starts with an empty one
+		// - call ClearTypeHierarchy() after modifying <typeinfos> directly
+		bool IsDerivedFrom(TypeID derivedID, TypeID baseID) const;
+		bool IsBaseOf(TypeID baseID, TypeID derivedID) const { return IsDerivedFrom(derivedID, baseID); }
+
+		void ClearTypeHierarchy() const;
+
 		ObjectPtr StaticCast_DerivedToBase (ObjectPtr obj, TypeID typeID) const;
 		ObjectPtr StaticCast_BaseToDerived (ObjectPtr obj, TypeID typeID) const;
 		ObjectPtr DynamicCast_BaseToDerived(ObjectPtr obj, TypeID typeID) const;
@@ -335,6 +465,12 @@ namespace Ubpa::UDRefl {
 		// all, for diamond inheritance
 		ConstObjectPtr RVar (ConstObjectPtr obj, TypeID baseID, StrID fieldID) const;
 
+		// resolve once, read/write many (FieldHandle::RVar/RWVar/Get/Set)
+		// - the field RVar(obj, fieldID) finds
+		// if typeID is a reference, dereference it
+		// if no field is found, return an invalid handle
+		FieldHandle ResolveField(TypeID typeID, StrID fieldID) const;
+
 		//
 		// Invoke
 		///////////
@@ -413,6 +549,70 @@ namespace Ubpa::UDRefl {
 		template<typename T, typename... Args>
 		T Invoke(ObjectPtr      obj, StrID methodID, Args&&... args) const;
 
+		// resolve and call in one step, std::nullopt if not invocable
+		// - T: non-void, non-reference result type
+
+		template<typename T>
+		std::optional<T> TryInvokeRet(TypeID      typeID, StrID methodID, std::span<const TypeID> argTypeIDs = {}, ArgsBuffer args_buffer = nullptr) const;
+		template<typename T>
+		std::optional<T> TryInvokeRet(ConstObjectPtr obj, StrID methodID, std::span<const TypeID> argTypeIDs = {}, ArgsBuffer args_buffer = nullptr) const;
+		template<typename T>
+		std::optional<T> TryInvokeRet(ObjectPtr      obj, StrID methodID, std::span<const TypeID> argTypeIDs = {}, ArgsBuffer args_buffer = nullptr) const;
+
+		template<typename T, typename... Args>
+		std::optional<T> TryInvoke(TypeID      typeID, StrID methodID, Args&&... args) const;
+		template<typename T, typename... Args>
+		std::optional<T> TryInvoke(ConstObjectPtr obj, StrID methodID, Args&&... args) const;
+		template<typename T, typename... Args>
+		std::optional<T> TryInvoke(ObjectPtr      obj, StrID methodID, Args&&... args) const;
+
+		//
+		// Batch
+		//////////
+		//
+		// - invoke methodID on each object of <objs> (not references), in order
+		// - the overload and the cast to the method's type are resolved once per TypeID
+		//   (once for a homogeneous span), then MethodPtr::Invoke runs in a loop
+		// - <args_buffers> : empty (no arguments), one (shared by the objects) or one per object
+		// - <result_buffers>: empty (results are discarded) or one per object, requires <results>
+		// - <results>       : empty or one per object, the destructor of results[i] is for result_buffers[i]
+		// - return the number of invoked objects, the others have no invocable method
+		//
+
+		std::size_t InvokeBatch(
+			std::span<const ObjectPtr> objs,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			std::span<const ArgsBuffer> args_buffers = {},
+			std::span<void* const> result_buffers = {},
+			std::span<InvokeResult> results = {}) const;
+
+		// the arguments are shared by the objects, results are discarded
+		template<typename... Args>
+		std::size_t InvokeBatchArgs(std::span<const ObjectPtr> objs, StrID methodID, Args&&... args) const;
+
+		//
+		// Array
+		//////////
+		//
+		// - element-wise arithmetic meta operators over contiguous arrays, by an ArrayKernel
+		// - op: operator_add/sub/mul/div (out[i] = lhs[i] op rhs[i]),
+		//       operator_assign_add/sub/mul/div (lhs[i] op= rhs[i], out = lhs)
+		// - typeID: the integer types (not bool), float and double, no promotion
+		// - no SharedObject per element, no overload resolution
+		// - return false if no kernel for (op, typeID) or the sizes mismatch
+		//
+
+		bool Apply(StrID op, TypeID typeID, std::size_t count, void* out, const void* lhs, const void* rhs) const;
+
+		// out[i] = lhs[i] op rhs[i]
+		template<typename T>
+		bool Apply(StrID op, std::span<const T> lhs, std::span<const T> rhs, std::span<T> out) const;
+
+		// lhs[i] op= rhs[i]
+		template<typename T>
+		bool Apply(StrID op, std::span<T> lhs, std::span<const T> rhs) const;
+
 		//
 		// Meta
 		/////////
@@ -427,6 +627,11 @@ namespace Ubpa::UDRefl {
 		bool Construct(ObjectPtr      obj, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const;
 		bool Destruct (ConstObjectPtr obj) const;
 
+		// the dtor Destruct calls, nullptr if not destructible or trivially destructible (nothing to call)
+		// - valid while the type is registered, call it without a lookup (e.g. ReflRegion)
+		const MethodPtr* GetDestructor(TypeID typeID) const;
+
+		// reflective global malloc/free/aligned_malloc/aligned_free (for scripts), New/Delete don't use them
 		void* Malloc(size_t size) const;
 		bool  Free  (void* ptr) const;
 
@@ -436,8 +641,22 @@ namespace Ubpa::UDRefl {
 		ObjectPtr New   (TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const;
 		bool      Delete(ConstObjectPtr obj) const;
 
+		// New/Delete/MakeShared allocate from it (but pooled types), std::pmr::new_delete_resource() by default
+		// - require: no object made by New is alive when it is replaced (a SharedObject keeps its resource)
+		void SetObjectResource(std::pmr::memory_resource* rsrc) noexcept;
+		std::pmr::memory_resource* GetObjectResource() const noexcept { return object_resource.load(std::memory_order_acquire); }
+
+		// the object and the control block are in one allocation (but large or over-aligned objects),
+		// the release calls the dtor resolved here
 		SharedObject MakeShared(TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const;
 
+		// New/Delete/MakeShared of the type draw from a slab pool of its size class (ObjectPool)
+		// - types of a size class share the pool, the first one sets blockCount (blocks per slab)
+		// - require: no object of the type made by New/MakeShared is alive
+		bool EnablePool(TypeID typeID, std::size_t blockCount = 64);
+		// nullptr if not enabled, it is also a memory resource for MNew/MDelete
+		ObjectPool* GetPool(TypeID typeID) const;
+
 		// -- template --
 
 		template<typename... Args>
@@ -541,6 +760,35 @@ namespace Ubpa::UDRefl {
 		std::vector<std::tuple<TypeRef, FieldRef, ConstObjectPtr>> GetTypeFieldROwnedVars (ConstObjectPtr obj);
 		std::vector<ConstObjectPtr>                                GetROwnedVars          (ConstObjectPtr obj);
 
+		// Parallel
+		// - over a work-stealing ThreadPool (SetThreadPool, ThreadPool::Default() if none),
+		//   the objects are split into chunks of <grain> (0: ThreadPool::DefaultGrain)
+		// - the caller blocks until all objects are visited
+
+		// the pool of the parallel algorithms, nullptr: ThreadPool::Default()
+		// - it must outlive the running algorithms
+		void SetThreadPool(ThreadPool* pool) noexcept { thread_pool.store(pool, std::memory_order_release); }
+		ThreadPool& GetThreadPool() const;
+
+		// func(worker, obj), worker in [0, GetThreadPool().NumWorkers()) for per-worker scratch state
+		// - a worker runs one chunk of a call at a time, a nested parallel call on it only runs its own chunks,
+		//   so the scratch state of a call isn't re-entered (a nested call needs its own)
+		void ParallelForEach(
+			std::span<const ObjectPtr> objs,
+			const std::function<void(std::size_t, ObjectPtr)>& func,
+			std::size_t grain = 0) const;
+
+		// func(T& acc, ObjectPtr obj) accumulates a chunk from <init>, the chunks fold in order with reduce(T, T) -> T
+		// - <init> must be the identity of reduce
+		// - deterministic: the chunks only depend on objs.size() and grain
+		template<typename T, typename Func, typename Reduce>
+		T ParallelReduce(
+			std::span<const ObjectPtr> objs,
+			T init,
+			Func&& func,
+			Reduce&& reduce,
+			std::size_t grain = 0) const;
+
 		// Find (DFS)
 
 		std::optional<TypeID   > FindTypeID    (TypeID      typeID, const std::function<bool(TypeID        )>& func) const;
@@ -560,7 +808,7 @@ namespace Ubpa::UDRefl {
 		//
 		// - MInvoke will allocate buffer for result, and move to SharedObject
 		// - if result is reference, SharedObject's Ptr is a pointer of referenced object
-		// - DMInvoke's 'D' means 'default' (use the default memory resource)
+		// - DMInvoke's 'D' means 'default' (use the default memory resource, or the thread's result arena in a ScratchScope)
 		//
 
 		SharedObject MInvoke(
@@ -629,6 +877,98 @@ namespace Ubpa::UDRefl {
 		template<typename... Args>
 		ObjectPtr MNew(TypeID typeID, std::pmr::memory_resource* rsrc, Args&&... args) const;
 
+		//
+		// Async
+		//////////
+		//
+		// - the overload is resolved synchronously, then the call runs on an Executor
+		//   (SetExecutor, ThreadPool::Default() if none)
+		// - the arguments of by value, const & and && parameters are copied (New) before returning,
+		//   deleted after the call
+		// - & parameters bind the caller's objects, they and obj must outlive the call
+		// - the future holds the result (a nullptr SharedObject if no method is invocable
+		//   or an argument can't be copied) or the exception of the method
+		// - InvokeAsync uses the default memory resource for the result
+		//
+
+		// nullptr: ThreadPool::Default()
+		// - it must outlive the scheduled calls
+		void SetExecutor(Executor* executor) noexcept { this->executor.store(executor, std::memory_order_release); }
+		Executor& GetExecutor() const;
+
+		std::future<SharedObject> MInvokeAsync(
+			TypeID typeID,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		std::future<SharedObject> MInvokeAsync(
+			ConstObjectPtr obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		std::future<SharedObject> MInvokeAsync(
+			ObjectPtr obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		template<typename... Args>
+		std::future<SharedObject> InvokeAsync(TypeID      typeID, StrID methodID, Args&&... args) const;
+		template<typename... Args>
+		std::future<SharedObject> InvokeAsync(ConstObjectPtr obj, StrID methodID, Args&&... args) const;
+		template<typename... Args>
+		std::future<SharedObject> InvokeAsync(ObjectPtr      obj, StrID methodID, Args&&... args) const;
+
+		//
+		// Coroutine
+		//////////////
+		//
+		// - methods returning Task<T> are added as usual, Task<T> is registered with the base TaskBase
+		// - the overload is resolved and the arguments are captured as InvokeAsync does before returning,
+		//   the copies live until the returned Task<SharedObject> ends
+		// - & parameters bind the caller's objects, they and obj must outlive the task
+		// - the method is invoked when the returned task is awaited (or started),
+		//   then its Task<T> is awaited and the result is yielded
+		//   (T moved into a SharedObject, SharedObject{ TypeID_of<void> } for Task<void>)
+		//   or its exception is rethrown
+		// - result_rsrc holds the method's Task<T>, not the yielded result
+		// - the result of a method not returning a Task is yielded as is, a nullptr SharedObject
+		//   if no method is invocable or an argument can't be copied
+		//
+
+		Task<SharedObject> MInvokeCo(
+			TypeID typeID,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		Task<SharedObject> MInvokeCo(
+			ConstObjectPtr obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		Task<SharedObject> MInvokeCo(
+			ObjectPtr obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs = {},
+			ArgsBuffer args_buffer = nullptr,
+			std::pmr::memory_resource* result_rsrc = std::pmr::get_default_resource()) const;
+
+		template<typename... Args>
+		Task<SharedObject> InvokeCo(TypeID      typeID, StrID methodID, Args&&... args) const;
+		template<typename... Args>
+		Task<SharedObject> InvokeCo(ConstObjectPtr obj, StrID methodID, Args&&... args) const;
+		template<typename... Args>
+		Task<SharedObject> InvokeCo(ObjectPtr      obj, StrID methodID, Args&&... args) const;
+
 		//
 		// Type
 		/////////
@@ -656,9 +996,74 @@ namespace Ubpa::UDRefl {
 		ReflMngr();
 		~ReflMngr();
 
-		// for
-		// - argument copy
-		mutable std::pmr::synchronized_pool_resource temporary_resource;
+		// published by Freeze() and the modifiers when frozen
+		struct FrozenSnapshot {
+			FrozenRegistry registry;
+			mutable MethodResolutionCache method_resolution_cache;
+			mutable CastPathCache cast_path_cache;
+			mutable TypeHierarchy type_hierarchy;
+		};
+
+		// require: write_mutex
+		// - false if the tables can't be built, then it unfreezes
+		bool Publish();
+
+		// nullptr if not frozen
+		std::atomic<const FrozenSnapshot*> frozen_snapshot{ nullptr };
+		// owner of frozen_snapshot, require: write_mutex
+		std::shared_ptr<const FrozenSnapshot> frozen_snapshot_owner;
+		mutable EpochDomain epochs;
+
+		std::recursive_mutex write_mutex;
+		std::size_t write_depth{ 0 };
+		bool write_modified{ false };
+
+		// not frozen
+		mutable MethodResolutionCache method_resolution_cache;
+		mutable CastPathCache cast_path_cache;
+		mutable TypeHierarchy type_hierarchy;
+
+		std::atomic<std::pmr::memory_resource*> object_resource{ std::pmr::new_delete_resource() };
+
+		std::atomic<ThreadPool*> thread_pool{ nullptr };
+		std::atomic<Executor*> executor{ nullptr };
+
+		// resolves and copies the by value, const & and && arguments into call, obj: nullptr for Static
+		// - false if no method is invocable or an argument can't be copied
+		bool CaptureCall(
+			details::CapturedCall& call,
+			MethodSearchMode mode,
+			TypeID typeID,
+			const void* obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs,
+			ArgsBuffer args_buffer,
+			std::pmr::memory_resource* result_rsrc) const;
+
+		// captures the call and schedules it on the Executor
+		std::future<SharedObject> ScheduleInvoke(
+			MethodSearchMode mode,
+			TypeID typeID,
+			const void* obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs,
+			ArgsBuffer args_buffer,
+			std::pmr::memory_resource* result_rsrc) const;
+
+		// captures the call, the task invokes it when awaited and owns the copies
+		Task<SharedObject> ScheduleInvokeCo(
+			MethodSearchMode mode,
+			TypeID typeID,
+			const void* obj,
+			StrID methodID,
+			std::span<const TypeID> argTypeIDs,
+			ArgsBuffer args_buffer,
+			std::pmr::memory_resource* result_rsrc) const;
+
+		// of EnablePool, require: write_mutex
+		std::vector<std::unique_ptr<ObjectPool>> pools;
+		// require: write_mutex
+		ObjectPool* FindOrCreatePool(std::size_t size, std::size_t alignment, std::size_t blockCount);
 	};
 
 	inline static std::add_const_t<ReflMngr*> Mngr = &ReflMngr::Instance();
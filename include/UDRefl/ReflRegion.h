@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ReflMngr.h"
+
+namespace Ubpa::UDRefl {
+	//
+	// objects constructed into a monotonic region (ReflMngr::MNew), destroyed together
+	// - the region records the dtor of each object (cached per TypeID), no lookup at the end
+	// - at Release() or the region's end, the dtors run in reverse order of construction,
+	//   then the memory is given back at once
+	// - the objects must not be Delete'd or MDelete'd one by one
+	// - owned by one thread
+	//
+	class ReflRegion {
+	public:
+		explicit ReflRegion(
+			std::size_t initial_size = 1024,
+			std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		~ReflRegion();
+
+		ReflRegion(const ReflRegion&) = delete;
+		ReflRegion& operator=(const ReflRegion&) = delete;
+
+		// nullptr if not constructible
+		ObjectPtr New(TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer);
+
+		template<typename... Args>
+		ObjectPtr New(TypeID typeID, Args&&... args);
+
+		// destroy the objects and release the memory, the region is reusable
+		void Release();
+
+		// objects with a dtor to call
+		std::size_t NumDestructors() const noexcept { return num_dtors; }
+
+		std::pmr::memory_resource* GetResource() noexcept { return &resource; }
+
+	private:
+		struct DtorEntry {
+			const MethodPtr* dtor;
+			const void* obj;
+		};
+
+		// entries in blocks from the region itself, linked backward
+		struct DtorBlock {
+			static constexpr std::size_t Capacity = 32;
+
+			DtorBlock* prev;
+			std::size_t size;
+			DtorEntry entries[Capacity];
+		};
+
+		// direct-mapped TypeID -> dtor
+		struct DtorCacheEntry {
+			TypeID typeID;
+			const MethodPtr* dtor{ nullptr };
+		};
+		static constexpr std::size_t DtorCacheSize = 8;
+
+		const MethodPtr* GetDestructor(TypeID typeID);
+		// makes room for an entry, so the push after the construction doesn't throw
+		void ReserveDestructor();
+		void DestroyAll() noexcept;
+
+		std::pmr::monotonic_buffer_resource resource;
+		DtorBlock* dtors{ nullptr };
+		std::size_t num_dtors{ 0 };
+		DtorCacheEntry dtor_cache[DtorCacheSize];
+	};
+}
+
+#include "details/ReflRegion.inl"
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace Ubpa::UDRefl {
+	//
+	// bump allocator for short-lived buffers, owned by one thread (no lock)
+	// - allocate bumps, deallocate only rewinds the last allocation
+	// - a Scope rewinds to where it began (LIFO), the chunks are kept for reuse
+	//
+	class ScratchArena final : public std::pmr::memory_resource {
+	public:
+		struct Marker {
+			void* chunk{ nullptr };
+			std::size_t offset{ 0 };
+		};
+
+		class Scope {
+		public:
+			explicit Scope(ScratchArena& arena) noexcept : arena{ arena }, marker{ arena.GetMarker() } {}
+			~Scope() { arena.Rewind(marker); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			ScratchArena& arena;
+			Marker marker;
+		};
+
+		explicit ScratchArena(
+			std::size_t chunk_size = 4096,
+			std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+		~ScratchArena();
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+
+		Marker GetMarker() const noexcept { return { cur, offset }; }
+		// marker must come from this arena, later markers become invalid
+		void Rewind(Marker marker) noexcept;
+		// rewind and give the chunks back to the upstream
+		void Release() noexcept;
+
+		// bytes of the chunks
+		std::size_t Capacity() const noexcept;
+
+		// the calling thread's arena for the argument temporaries of Invoke/MInvoke/New/...
+		static ScratchArena& ArgumentArena() noexcept;
+		// the calling thread's arena for the results in a ScratchScope
+		static ScratchArena& ResultArena() noexcept;
+
+	private:
+		struct Chunk {
+			Chunk* next;
+			std::size_t size; // bytes after the header
+		};
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		static std::byte* Data(Chunk* chunk) noexcept;
+
+		std::pmr::memory_resource* upstream;
+		std::size_t chunk_size;
+
+		// chunks in order, <cur> is the one in use, the later ones are free
+		Chunk* head{ nullptr };
+		Chunk* cur{ nullptr };
+		std::size_t offset{ 0 };
+	};
+
+	//
+	// DMInvoke/ADMInvoke (so the meta operators, e.g. ObjectPtr::operator+) of the calling thread
+	// put their results in ScratchArena::ResultArena() until the scope ends
+	// - the results must not outlive the scope
+	// - scopes nest (LIFO), a method invoked in a scope shares it
+	//
+	class ScratchScope {
+	public:
+		ScratchScope() noexcept;
+		~ScratchScope();
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+		// the result arena in a scope, else the default memory resource
+		static std::pmr::memory_resource* ResultResource() noexcept;
+
+	private:
+		ScratchArena::Scope scope;
+	};
+}
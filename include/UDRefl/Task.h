@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Object.h"
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Ubpa::UDRefl {
+	template<typename T = void>
+	class Task;
+
+	namespace details {
+		struct TaskPromiseBase {
+			// resumes the awaiting coroutine (symmetric transfer), if any
+			struct FinalAwaiter {
+				bool await_ready() const noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+					std::coroutine_handle<> continuation = handle.promise().continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+			void RethrowIfFailed() const {
+				if (exception)
+					std::rethrow_exception(exception);
+			}
+
+			// the result moved into a SharedObject, rethrows the exception of the coroutine
+			virtual SharedObject TakeResult() = 0;
+
+			std::coroutine_handle<> continuation;
+			std::exception_ptr exception;
+
+		protected:
+			~TaskPromiseBase() = default;
+		};
+
+		template<typename T>
+		struct TaskPromise final : TaskPromiseBase {
+			Task<T> get_return_object() noexcept;
+
+			template<typename U = T>
+			void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
+
+			T Result() {
+				RethrowIfFailed();
+				assert(result.has_value());
+				return std::move(*result);
+			}
+
+			SharedObject TakeResult() override {
+				return { TypeID_of<T>, std::make_shared<T>(Result()) };
+			}
+
+			std::optional<T> result;
+		};
+
+		template<>
+		struct TaskPromise<void> final : TaskPromiseBase {
+			Task<void> get_return_object() noexcept;
+
+			void return_void() const noexcept {}
+
+			void Result() const { RethrowIfFailed(); }
+
+			SharedObject TakeResult() override {
+				Result();
+				return SharedObject{ TypeID_of<void> };
+			}
+		};
+	}
+
+	//
+	// the type erased part of Task<T>, owns the coroutine
+	// - ReflMngr registers it as a base of the Task<T> of the methods (ReflMngr::InvokeCo)
+	// - co_await yields nothing, then TakeResult() gives the result
+	//
+	class TaskBase {
+	public:
+		TaskBase() noexcept = default;
+		~TaskBase() { Reset(); }
+
+		TaskBase(TaskBase&& other) noexcept :
+			handle{ std::exchange(other.handle, nullptr) },
+			promise{ std::exchange(other.promise, nullptr) } {}
+
+		TaskBase& operator=(TaskBase&& rhs) noexcept {
+			if (this != &rhs) {
+				Reset();
+				handle = std::exchange(rhs.handle, nullptr);
+				promise = std::exchange(rhs.promise, nullptr);
+			}
+			return *this;
+		}
+
+		bool Valid() const noexcept { return static_cast<bool>(handle); }
+		bool IsReady() const noexcept { return handle && handle.done(); }
+
+		// runs the coroutine until its first suspension (it starts suspended)
+		// - a task is started once, by Start() or co_await
+		void Start() const {
+			assert(Valid() && !handle.done());
+			handle.resume();
+		}
+
+		// IsReady() must be true
+		SharedObject TakeResult() const {
+			assert(IsReady());
+			return promise->TakeResult();
+		}
+
+		auto operator co_await() const noexcept {
+			struct Awaiter {
+				const TaskBase& task;
+
+				bool await_ready() const noexcept { return task.handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+					task.promise->continuation = awaiting;
+					return task.handle;
+				}
+
+				void await_resume() const { task.promise->RethrowIfFailed(); }
+			};
+			assert(Valid());
+			return Awaiter{ *this };
+		}
+
+	protected:
+		TaskBase(std::coroutine_handle<> handle, details::TaskPromiseBase* promise) noexcept :
+			handle{ handle }, promise{ promise } {}
+
+		void Reset() noexcept {
+			if (handle) {
+				handle.destroy();
+				handle = nullptr;
+				promise = nullptr;
+			}
+		}
+
+		std::coroutine_handle<> handle;
+		details::TaskPromiseBase* promise{ nullptr };
+	};
+
+	//
+	// lazy coroutine task, the return type of the asynchronous methods
+	// - co_await yields T (moved from the coroutine) or rethrows its exception
+	// - the continuation is resumed on the thread completing the task
+	//
+	template<typename T>
+	class Task : public TaskBase {
+	public:
+		static_assert(!std::is_reference_v<T>);
+
+		using promise_type = details::TaskPromise<T>;
+
+		Task() noexcept = default;
+
+		auto operator co_await() const noexcept {
+			struct Awaiter {
+				const Task& task;
+
+				bool await_ready() const noexcept { return task.handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+					task.promise->continuation = awaiting;
+					return task.handle;
+				}
+
+				T await_resume() const { return static_cast<promise_type*>(task.promise)->Result(); }
+			};
+			assert(Valid());
+			return Awaiter{ *this };
+		}
+
+	private:
+		friend promise_type;
+
+		explicit Task(promise_type& promise) noexcept :
+			TaskBase{ std::coroutine_handle<promise_type>::from_promise(promise), &promise } {}
+	};
+
+	template<typename T> struct IsTask : std::false_type {};
+	template<typename T> struct IsTask<Task<T>> : std::true_type {};
+	template<typename T> constexpr bool IsTask_v = IsTask<T>::value;
+}
+
+namespace Ubpa::UDRefl::details {
+	template<typename T>
+	Task<T> TaskPromise<T>::get_return_object() noexcept { return Task<T>{ *this }; }
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept { return Task<void>{ *this }; }
+}
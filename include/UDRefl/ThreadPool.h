@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Executor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// work-stealing thread pool
+	// - each worker has a deque, it pops its own tasks from the back and steals from the front of the others
+	// - tasks submitted by a worker go to its own deque, the others' are dealt round-robin
+	// - ParallelFor chunks are claimed from a counter by helper tasks and by a calling worker,
+	//   which only runs the chunks of its own call meanwhile (nested ParallelFor don't deadlock,
+	//   a chunk on a worker's stack isn't re-entered by another one)
+	// - the destructor runs the pending tasks, then joins the workers
+	// - an Executor, Execute is Submit
+	//
+	class ThreadPool final : public Executor {
+	public:
+		explicit ThreadPool(std::size_t num_workers = DefaultNumWorkers());
+		~ThreadPool() override;
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		std::size_t NumWorkers() const noexcept { return workers.size(); }
+
+		// index of the calling thread in [0, NumWorkers()), NumWorkers() if it isn't a worker of this pool
+		std::size_t WorkerIndex() const noexcept;
+
+		// task must not throw
+		void Submit(std::function<void()> task);
+
+		void Execute(std::function<void()> task) override { Submit(std::move(task)); }
+
+		// func(worker, chunk, begin, end) for the chunks [begin, end) of [0, count), <grain> elements each
+		// - grain 0: DefaultGrain(count)
+		// - the chunks only depend on count and grain, not on the scheduling
+		// - blocks until all the chunks are done, then rethrows the first exception of func
+		void ParallelFor(
+			std::size_t count,
+			std::size_t grain,
+			const std::function<void(std::size_t worker, std::size_t chunk, std::size_t begin, std::size_t end)>& func);
+
+		// a few chunks per worker
+		std::size_t DefaultGrain(std::size_t count) const noexcept;
+
+		static std::size_t NumChunks(std::size_t count, std::size_t grain) noexcept { return (count + grain - 1) / grain; }
+
+		static std::size_t DefaultNumWorkers() noexcept;
+
+		// hardware concurrency workers, created at the first call
+		static ThreadPool& Default();
+
+	private:
+		struct Worker {
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+			std::thread thread;
+		};
+
+		// own back first, then the others' front
+		bool TryPop(std::size_t index, std::function<void()>& task);
+		void Run(std::size_t index);
+
+		std::vector<std::unique_ptr<Worker>> workers;
+
+		std::mutex sleep_mutex;
+		std::condition_variable sleep_cv;
+		// queued tasks, signed: a pop may run before the push is counted
+		std::atomic<std::ptrdiff_t> num_pending{ 0 };
+		bool stop{ false }; // require: sleep_mutex
+
+		std::atomic<std::size_t> next_worker{ 0 };
+	};
+}
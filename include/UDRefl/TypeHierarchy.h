@@ -0,0 +1,53 @@
+#pragma once
+
+#include "InsertOnlyHashMap.h"
+#include "Util.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Ubpa::UDRefl {
+	//
+	// hierarchy encoding for constant time subtype tests
+	// - every encoded type gets a dense index
+	// - a type's node is the bitset of the indices of its bases (direct, indirect and virtual ones)
+	//   and itself, the union of its direct bases' bitsets
+	// - a type is encoded after all its bases, so if baseID isn't encoded after derivedID,
+	//   it isn't a base of derivedID
+	// - lock-free Find, concurrent Insert, the nodes are immutable and stable until Clear()
+	// - Clear() must not run concurrently with Find
+	// - ReflMngr fills it lazily and clears it when bases are added
+	//
+	class TypeHierarchy {
+	public:
+		struct Node {
+			std::size_t index;
+			std::vector<std::uint64_t> bases;
+
+			bool Has(std::size_t i) const noexcept {
+				return i / 64 < bases.size() && (bases[i / 64] >> (i % 64)) & 1;
+			}
+
+			bool IsDerivedFrom(const Node& base) const noexcept { return Has(base.index); }
+
+			// bases |= base.bases
+			void Merge(const Node& base);
+		};
+
+		// nullptr if not encoded
+		const Node* Find(TypeID typeID) const noexcept { return nodes.Find(typeID); }
+
+		// <bases> : the union of the direct bases' bitsets
+		// if typeID is encoded, the old node is kept
+		const Node& Insert(TypeID typeID, std::vector<std::uint64_t> bases);
+
+		void Clear() noexcept { nodes.Clear(); }
+
+		std::size_t Size() const noexcept { return nodes.Size(); }
+
+	private:
+		// serializes Insert, the indices are dense
+		std::mutex mutex;
+		InsertOnlyHashMap<TypeID, Node> nodes;
+	};
+}
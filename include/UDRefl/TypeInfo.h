@@ -3,8 +3,58 @@
 #include "FieldInfo.h"
 #include "MethodInfo.h"
 #include "BaseInfo.h"
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
 
 namespace Ubpa::UDRefl {
+	namespace details {
+		// T() is all zero bytes, e.g. false for a null pointer to data member (-1 on the Itanium ABI)
+		// - checked once on a value-initialized object, undetermined padding makes it false
+		template<typename T>
+		bool IsZeroInitializable() noexcept {
+			if constexpr (!std::is_trivially_default_constructible_v<T>)
+				return false;
+			else {
+				alignas(T) unsigned char buffer[sizeof(T)];
+				std::memset(buffer, 0xff, sizeof(T));
+				::new(static_cast<void*>(buffer)) T();
+				return std::all_of(buffer, buffer + sizeof(T), [](unsigned char byte) { return byte == 0; });
+			}
+		}
+	}
+
+	// C++ traits captured by RegisterType<T>, all false for a type registered by name
+	// - they enable the memcpy/no-op paths of Construct/Destruct and the argument copies,
+	//   so the registered ctors/dtor are assumed to be the C++ ones
+	struct TypeTraits {
+		bool is_trivially_copyable{ false };
+		bool is_trivially_destructible{ false };
+		bool is_trivially_default_constructible{ false };
+		bool is_standard_layout{ false };
+		bool is_polymorphic{ false };
+		// trivially default constructible and T() is all zero bytes, T{} is a memset
+		bool is_zero_initializable{ false };
+		// T(const T&) and T(T&&) are trivial (not deleted), T{arg} is a memcpy
+		bool is_trivially_copy_constructible{ false };
+
+		template<typename T>
+		static TypeTraits Of() noexcept {
+			return {
+				std::is_trivially_copyable_v<T>,
+				std::is_trivially_destructible_v<T>,
+				std::is_trivially_default_constructible_v<T>,
+				std::is_standard_layout_v<T>,
+				std::is_polymorphic_v<T>,
+				details::IsZeroInitializable<T>(),
+				std::is_trivially_copy_constructible_v<T> && std::is_trivially_move_constructible_v<T>
+			};
+		}
+	};
+
 	struct TypeInfo {
 		size_t size;
 		size_t alignment;
@@ -12,5 +62,10 @@ namespace Ubpa::UDRefl {
 		std::unordered_multimap<StrID, MethodInfo> methodinfos;
 		std::unordered_map<TypeID, BaseInfo> baseinfos;
 		AttrSet attrs;
+		// New/Delete draw from it if not nullptr (ReflMngr::EnablePool)
+		ObjectPool* pool{ nullptr };
+		// MakeShared draws the object and its control block from it if not nullptr
+		ObjectPool* shared_pool{ nullptr };
+		TypeTraits traits;
 	};
 }
@@ -1,14 +1,31 @@
 #pragma once
 
+#include "ArgumentConversionPlan.h"
+#include "ArrayKernel.h"
 #include "AttrSet.h"
 #include "BaseInfo.h"
 #include "Basic.h"
+#include "CastPathCache.h"
+#include "EpochDomain.h"
+#include "Executor.h"
+#include "FieldHandle.h"
 #include "FieldInfo.h"
 #include "FieldPtr.h"
+#include "FrozenRegistry.h"
 #include "IDRegistry.h"
+#include "InsertOnlyHashMap.h"
+#include "MethodHandle.h"
 #include "MethodInfo.h"
 #include "MethodPtr.h"
+#include "MethodResolutionCache.h"
 #include "Object.h"
+#include "ObjectPool.h"
+#include "PerfectHashTable.h"
 #include "ReflMngr.h"
+#include "ReflRegion.h"
+#include "ScratchArena.h"
+#include "Task.h"
+#include "ThreadPool.h"
+#include "TypeHierarchy.h"
 #include "TypeInfo.h"
 #include "Util.h"
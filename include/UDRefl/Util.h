@@ -45,6 +45,27 @@ namespace Ubpa::UDRefl {
 		};
 	}
 
+	// Offsetor without type erasure
+	// - context: an optional word (e.g. an out-of-line functor), nullptr if unused
+	using OffsetFunction = const void* (const void* obj, const void* context);
+
+	// Func: const void*(const void*), stateless (e.g. captureless lambda)
+	template<typename Func>
+	constexpr OffsetFunction* stateless_offset_function() noexcept {
+		static_assert(std::is_empty_v<Func> && std::is_default_constructible_v<Func>);
+		return [](const void* obj, const void*) -> const void* {
+			return Func{}(obj);
+		};
+	}
+
+	// Func: const void*(const void*), the context is a const Func*
+	template<typename Func>
+	constexpr OffsetFunction* contextual_offset_function() noexcept {
+		return [](const void* obj, const void* context) -> const void* {
+			return (*reinterpret_cast<const Func*>(context))(obj);
+		};
+	}
+
 	struct InheritCastFunctions {
 		Offsetor static_derived_to_base;
 		Offsetor static_base_to_derived;
@@ -110,6 +131,16 @@ namespace Ubpa::UDRefl {
 		}
 	}
 
+	// non virtual Base: base = derived + offset
+	// - measured on aligned storage of Derived, no object is accessed
+	template<typename Derived, typename Base>
+	std::size_t base_forward_offset_value() noexcept {
+		static_assert(std::is_base_of_v<Base, Derived> && !is_virtual_base_of_v<Base, Derived>);
+		alignas(Derived) std::uint8_t storage[sizeof(Derived)];
+		const Derived* derived = reinterpret_cast<const Derived*>(storage);
+		return static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(static_cast<const Base*>(derived)) - storage);
+	}
+
 	template<typename T>
 	Destructor destructor() {
 		if constexpr (std::is_fundamental_v<T> || std::is_compound_v<T>)
@@ -14,6 +14,12 @@ namespace Ubpa::UDRefl {
 
 	template<typename T>
 	void IDRegistry<T>::RegisterUnmanaged(T ID, std::string_view name) {
+		std::unique_lock lock{ mutex };
+		RegisterUnmanaged_Unlocked(ID, name);
+	}
+
+	template<typename T>
+	void IDRegistry<T>::RegisterUnmanaged_Unlocked(T ID, std::string_view name) {
 		auto target = id2name.find(ID);
 		if (target != id2name.end()) {
 			assert(target->second == name);
@@ -36,6 +42,12 @@ namespace Ubpa::UDRefl {
 
 	template<typename T>
 	void IDRegistry<T>::Register(T ID, std::string_view name) {
+		std::unique_lock lock{ mutex };
+		Register_Unlocked(ID, name);
+	}
+
+	template<typename T>
+	void IDRegistry<T>::Register_Unlocked(T ID, std::string_view name) {
 		auto target = id2name.find(ID);
 		if (target != id2name.end()) {
 			assert(target->second == name);
@@ -68,6 +80,7 @@ namespace Ubpa::UDRefl {
 
 	template<typename T>
 	void IDRegistry<T>::UnregisterUnmanaged(T ID) {
+		std::unique_lock lock{ mutex };
 		auto target = id2name.find(ID);
 		if (target == id2name.end())
 			return;
@@ -79,6 +92,7 @@ namespace Ubpa::UDRefl {
 
 	template<typename T>
 	void IDRegistry<T>::Clear() noexcept {
+		std::unique_lock lock{ mutex };
 		id2name.clear();
 #ifndef NDEBUG
 		unmanagedIDs.clear();
@@ -89,11 +103,13 @@ namespace Ubpa::UDRefl {
 #ifndef NDEBUG
 	template<typename T>
 	bool IDRegistry<T>::IsUnmanaged(T ID) const {
+		std::shared_lock lock{ mutex };
 		return unmanagedIDs.find(ID) != unmanagedIDs.end();
 	}
 
 	template<typename T>
 	void IDRegistry<T>::ClearUnmanaged() noexcept {
+		std::unique_lock lock{ mutex };
 		for (const auto& ID : unmanagedIDs)
 			id2name.erase(ID);
 		unmanagedIDs.clear();
@@ -103,11 +119,18 @@ namespace Ubpa::UDRefl {
 
 	template<typename T>
 	bool IDRegistry<T>::IsRegistered(T ID) const {
+		std::shared_lock lock{ mutex };
 		return id2name.find(ID) != id2name.end();
 	}
 
 	template<typename T>
 	std::string_view IDRegistry<T>::Nameof(T ID) const {
+		std::shared_lock lock{ mutex };
+		return Nameof_Unlocked(ID);
+	}
+
+	template<typename T>
+	std::string_view IDRegistry<T>::Nameof_Unlocked(T ID) const {
 		auto target = id2name.find(ID);
 		if (target != id2name.end())
 			return target->second;
@@ -118,7 +141,9 @@ namespace Ubpa::UDRefl {
 	template<typename T>
 	void TypeIDRegistry::Register() {
 		static_assert(!std::is_const_v<T> || !std::is_volatile_v<T>);
-		IDRegistry<TypeID>::RegisterUnmanaged(TypeID_of<T>, type_name<T>());
+		std::unique_lock lock{ mutex };
+		IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(TypeID_of<T>, type_name<T>());
+		RegisterShape(TypeID_of<T>, type_name<T>());
 	}
 
 
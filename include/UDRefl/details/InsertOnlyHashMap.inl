@@ -0,0 +1,93 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+
+namespace Ubpa::UDRefl {
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::Table::Table(std::size_t capacity) :
+		mask{ capacity - 1 },
+		shift{ static_cast<unsigned>(64 - std::countr_zero(capacity)) },
+		slots{ new std::atomic<const Entry*>[capacity]() }
+	{
+		assert(std::has_single_bit(capacity) && capacity > 1);
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	template<typename K>
+	const typename InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::Entry*
+	InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::FindEntry(const Table* table, std::size_t hash, const K& key) const noexcept {
+		// at most half full, a probe sequence ends at an empty slot
+		for (std::size_t i = table->Index(hash);; i = (i + 1) & table->mask) {
+			const Entry* entry = table->slots[i].load(std::memory_order_acquire);
+			if (!entry)
+				return nullptr;
+			if (entry->hash == hash && KeyEqual{}(entry->key, key))
+				return entry;
+		}
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	template<typename K>
+	const Value* InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::Find(const K& key) const noexcept {
+		const Table* t = table.load(std::memory_order_acquire);
+		if (!t)
+			return nullptr;
+
+		const Entry* entry = FindEntry(t, Hash{}(key), key);
+		return entry ? &entry->value : nullptr;
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	const Value& InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::InsertEntry(std::unique_ptr<Entry> entry) {
+		const std::size_t n = size.load(std::memory_order_relaxed) + 1;
+		const Table* t = table.load(std::memory_order_relaxed);
+		if (!t || n * 2 > t->mask + 1) {
+			// copy into a twice bigger table, then publish it
+			auto bigger = std::make_unique<Table>(t ? (t->mask + 1) * 2 : 16);
+			for (const auto& e : entries) {
+				std::size_t i = bigger->Index(e->hash);
+				while (bigger->slots[i].load(std::memory_order_relaxed))
+					i = (i + 1) & bigger->mask;
+				bigger->slots[i].store(e.get(), std::memory_order_relaxed);
+			}
+			t = bigger.get();
+			tables.push_back(std::move(bigger));
+			table.store(t, std::memory_order_release);
+		}
+
+		std::size_t i = t->Index(entry->hash);
+		while (t->slots[i].load(std::memory_order_relaxed))
+			i = (i + 1) & t->mask;
+
+		const Entry* e = entry.get();
+		entries.push_back(std::move(entry));
+		t->slots[i].store(e, std::memory_order_release);
+		size.store(n, std::memory_order_relaxed);
+
+		return e->value;
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	const Value& InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::Insert(Key key, Value value) {
+		const std::size_t hash = Hash{}(key);
+
+		std::lock_guard lock{ mutex };
+
+		if (const Table* t = table.load(std::memory_order_relaxed)) {
+			if (const Entry* entry = FindEntry(t, hash, key))
+				return entry->value;
+		}
+
+		return InsertEntry(std::unique_ptr<Entry>{ new Entry{ hash, std::move(key), std::move(value) } });
+	}
+
+	template<typename Key, typename Value, typename Hash, typename KeyEqual>
+	void InsertOnlyHashMap<Key, Value, Hash, KeyEqual>::Clear() noexcept {
+		std::lock_guard lock{ mutex };
+		table.store(nullptr, std::memory_order_release);
+		tables.clear();
+		entries.clear();
+		size.store(0, std::memory_order_relaxed);
+	}
+}
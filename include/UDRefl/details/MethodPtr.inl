@@ -0,0 +1,72 @@
+#pragma once
+
+namespace Ubpa::UDRefl {
+	template<typename Func>
+	constexpr MethodPtr::Kind MethodPtr::CallableKindOf() noexcept {
+		if constexpr (std::is_invocable_r_v<Destructor, Func&, void*, ArgsView>)
+			return Kind::StaticCallable;
+		else if constexpr (std::is_invocable_r_v<Destructor, Func&, const void*, void*, ArgsView>)
+			return Kind::MemberConstCallable;
+		else {
+			static_assert(std::is_invocable_r_v<Destructor, Func&, void*, void*, ArgsView>);
+			return Kind::MemberVariableCallable;
+		}
+	}
+
+	template<typename Func, std::enable_if_t<!std::is_same_v<std::decay_t<Func>, MethodPtr>
+		&& !std::is_pointer_v<std::decay_t<Func>>, int>>
+	MethodPtr::MethodPtr(Func&& func, ResultDesc resultDesc, ParamList paramList) :
+		resultDesc{ std::move(resultDesc) },
+		paramList{ std::move(paramList) }
+	{
+		using F = std::decay_t<Func>;
+		constexpr Kind callable_kind = CallableKindOf<F>();
+
+		if constexpr (std::is_empty_v<F> && std::is_default_constructible_v<F>) {
+			if constexpr (callable_kind == Kind::MemberVariableCallable) {
+				kind = Kind::MemberVariable;
+				memberVariableFunction = [](void* obj, void* result_buffer, ArgsView args) -> Destructor {
+					return F{}(obj, result_buffer, args);
+				};
+			}
+			else if constexpr (callable_kind == Kind::MemberConstCallable) {
+				kind = Kind::MemberConst;
+				memberConstFunction = [](const void* obj, void* result_buffer, ArgsView args) -> Destructor {
+					return F{}(obj, result_buffer, args);
+				};
+			}
+			else {
+				kind = Kind::Static;
+				staticFunction = [](void* result_buffer, ArgsView args) -> Destructor {
+					return F{}(result_buffer, args);
+				};
+			}
+		}
+		else {
+			if constexpr (std::is_constructible_v<bool, const F&>)
+				assert(static_cast<bool>(func));
+
+			if constexpr (IsInlineCallable<F>())
+				new(&callable) F(std::forward<Func>(func));
+			else
+				storage = std::make_shared<F>(std::forward<Func>(func));
+
+			kind = callable_kind;
+			if constexpr (callable_kind == Kind::MemberVariableCallable) {
+				memberVariableInvoker = [](void* f, void* obj, void* result_buffer, ArgsView args) -> Destructor {
+					return (*static_cast<F*>(f))(obj, result_buffer, args);
+				};
+			}
+			else if constexpr (callable_kind == Kind::MemberConstCallable) {
+				memberConstInvoker = [](void* f, const void* obj, void* result_buffer, ArgsView args) -> Destructor {
+					return (*static_cast<F*>(f))(obj, result_buffer, args);
+				};
+			}
+			else {
+				staticInvoker = [](void* f, void* result_buffer, ArgsView args) -> Destructor {
+					return (*static_cast<F*>(f))(result_buffer, args);
+				};
+			}
+		}
+	}
+}
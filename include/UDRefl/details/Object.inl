@@ -87,13 +87,8 @@ namespace Ubpa::UDRefl {
 			if (Is<bool>())
 				return As<bool>();
 			else {
-				auto rst = IsInvocable(StrIDRegistry::MetaID::operator_bool);
-				if (rst.success) {
-					assert(rst.result_desc.typeID == TypeID_of<bool>);
-					return Invoke<bool>(StrIDRegistry::MetaID::operator_bool);
-				}
-				else
-					return true;
+				// one resolution, true if operator bool is not invocable
+				return TryInvoke<bool>(StrIDRegistry::MetaID::operator_bool).value_or(true);
 			}
 		}
 		else
@@ -137,6 +132,28 @@ namespace Ubpa::UDRefl {
 			return InvokeRet<T>(methodID);
 	}
 
+	template<typename T>
+	std::optional<T> ObjectPtrBase::TryInvokeRet(StrID methodID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+		static_assert(!std::is_void_v<T> && !std::is_reference_v<T>);
+		alignas(T) std::uint8_t result_buffer[sizeof(T)];
+		InvokeResult result = Invoke(methodID, result_buffer, argTypeIDs, args_buffer);
+		if (!result.success)
+			return std::nullopt;
+		assert(result.resultID == TypeID_of<T>);
+		return result.Move<T>(result_buffer);
+	}
+
+	template<typename T, typename... Args>
+	std::optional<T> ObjectPtrBase::TryInvoke(StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return TryInvokeRet<T>(methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return TryInvokeRet<T>(methodID);
+	}
+
 	template<typename... Args>
 	SharedObject ObjectPtrBase::MInvoke(
 		StrID methodID,
@@ -157,7 +174,7 @@ namespace Ubpa::UDRefl {
 		StrID methodID,
 		Args&&... args) const
 	{
-		return MInvoke(methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return MInvoke(methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	template<typename T, typename... Args>
@@ -191,7 +208,7 @@ namespace Ubpa::UDRefl {
 		StrID methodID,
 		Args&&... args) const
 	{
-		return AMInvoke(methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return AMInvoke(methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 	
 	OBJECT_PTR_DEFINE_OPERATOR_T(ObjectPtrBase, +, add)
@@ -268,6 +285,28 @@ namespace Ubpa::UDRefl {
 			return InvokeRet<T>(methodID);
 	}
 
+	template<typename T>
+	std::optional<T> ObjectPtr::TryInvokeRet(StrID methodID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+		static_assert(!std::is_void_v<T> && !std::is_reference_v<T>);
+		alignas(T) std::uint8_t result_buffer[sizeof(T)];
+		InvokeResult result = Invoke(methodID, result_buffer, argTypeIDs, args_buffer);
+		if (!result.success)
+			return std::nullopt;
+		assert(result.resultID == TypeID_of<T>);
+		return result.Move<T>(result_buffer);
+	}
+
+	template<typename T, typename... Args>
+	std::optional<T> ObjectPtr::TryInvoke(StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return TryInvokeRet<T>(methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return TryInvokeRet<T>(methodID);
+	}
+
 	template<typename... Args>
 	SharedObject ObjectPtr::MInvoke(
 		StrID methodID,
@@ -285,7 +324,7 @@ namespace Ubpa::UDRefl {
 
 	template<typename... Args>
 	SharedObject ObjectPtr::DMInvoke(StrID methodID, Args&&... args) const {
-		return MInvoke(methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return MInvoke(methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	// A means auto, ObjectPtr/SharedObject will be transform as ID + ptr
@@ -317,7 +356,7 @@ namespace Ubpa::UDRefl {
 
 	template<typename... Args>
 	SharedObject ObjectPtr::ADMInvoke(StrID methodID, Args&&... args) const {
-		return AMInvoke(methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return AMInvoke(methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	template<typename Arg,
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace Ubpa::UDRefl::details {
+	constexpr std::uint64_t perfect_hash_mix(std::uint64_t x) noexcept {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ull;
+		x ^= x >> 33;
+		return x;
+	}
+}
+
+namespace Ubpa::UDRefl {
+	template<typename Key, typename Value>
+	std::size_t PerfectHashTable<Key, Value>::BucketIndex(std::uint64_t h) const noexcept {
+		return static_cast<std::size_t>((h * 0x9e3779b97f4a7c15ull) >> bucket_shift);
+	}
+
+	template<typename Key, typename Value>
+	std::size_t PerfectHashTable<Key, Value>::SlotIndex(std::uint64_t h, std::uint32_t displacement) const noexcept {
+		return static_cast<std::size_t>(details::perfect_hash_mix(h + displacement * 0x9e3779b97f4a7c15ull) & (slots.size() - 1));
+	}
+
+	template<typename Key, typename Value>
+	bool PerfectHashTable<Key, Value>::Build(std::vector<std::pair<Key, Value>> items) {
+		Clear();
+		if (items.empty())
+			return true;
+
+#ifndef NDEBUG
+		for (const auto& [key, value] : items)
+			assert(key.Valid());
+#endif // !NDEBUG
+
+		{ // duplicated keys can't be placed at any size
+			std::vector<std::uint64_t> hashes(items.size());
+			for (std::size_t i = 0; i < items.size(); i++)
+				hashes[i] = items[i].first.GetValue();
+			std::sort(hashes.begin(), hashes.end());
+			if (std::adjacent_find(hashes.begin(), hashes.end()) != hashes.end())
+				return false;
+		}
+
+		constexpr std::uint32_t max_displacement = 1 << 16;
+		// unique keys are placed at the first size in practice
+		constexpr std::size_t max_attempts = 4;
+
+		const std::size_t bucket_count = std::max<std::size_t>(std::bit_ceil(items.size()) / 2, 2);
+		bucket_shift = static_cast<std::uint32_t>(64 - std::countr_zero(bucket_count));
+
+		std::vector<std::vector<std::size_t>> buckets(bucket_count);
+		for (std::size_t i = 0; i < items.size(); i++)
+			buckets[BucketIndex(items[i].first.GetValue())].push_back(i);
+
+		// place big buckets first
+		std::vector<std::size_t> order(bucket_count);
+		for (std::size_t i = 0; i < bucket_count; i++)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+			return buckets[lhs].size() > buckets[rhs].size();
+		});
+
+		std::size_t slot_count = std::bit_ceil(items.size() * 2);
+		std::vector<std::size_t> item_slots(items.size());
+		std::vector<std::size_t> bucket_slots;
+		for (std::size_t attempt = 0; ; attempt++) {
+			slots.resize(slot_count); // SlotIndex uses slots.size()
+			displacements.assign(bucket_count, 0);
+			std::vector<bool> used(slot_count, false);
+
+			bool success = true;
+			for (std::size_t b : order) {
+				const auto& bucket = buckets[b];
+				if (bucket.empty())
+					break;
+
+				std::uint32_t d = 0;
+				for (; d < max_displacement; d++) {
+					bucket_slots.clear();
+					bool placed = true;
+					for (std::size_t i : bucket) {
+						std::size_t s = SlotIndex(items[i].first.GetValue(), d);
+						if (used[s] || std::find(bucket_slots.begin(), bucket_slots.end(), s) != bucket_slots.end()) {
+							placed = false;
+							break;
+						}
+						bucket_slots.push_back(s);
+					}
+					if (placed)
+						break;
+				}
+
+				if (d == max_displacement) {
+					success = false;
+					break;
+				}
+
+				displacements[b] = d;
+				for (std::size_t k = 0; k < bucket.size(); k++) {
+					used[bucket_slots[k]] = true;
+					item_slots[bucket[k]] = bucket_slots[k];
+				}
+			}
+
+			if (success)
+				break;
+
+			if (attempt + 1 == max_attempts) {
+				Clear();
+				return false;
+			}
+
+			slots.clear();
+			slot_count *= 2;
+		}
+
+		slots.assign(slot_count, Slot{});
+		for (std::size_t i = 0; i < items.size(); i++)
+			slots[item_slots[i]] = { items[i].first, std::move(items[i].second) };
+		size = items.size();
+		return true;
+	}
+
+	template<typename Key, typename Value>
+	void PerfectHashTable<Key, Value>::Clear() noexcept {
+		displacements.clear();
+		slots.clear();
+		size = 0;
+		bucket_shift = 63;
+	}
+
+	template<typename Key, typename Value>
+	const Value* PerfectHashTable<Key, Value>::Find(Key key) const noexcept {
+		if (slots.empty())
+			return nullptr;
+
+		const std::uint64_t h = key.GetValue();
+		const Slot& slot = slots[SlotIndex(h, displacements[BucketIndex(h)])];
+		return slot.key == key && key.Valid() ? &slot.value : nullptr;
+	}
+
+	template<typename Key, typename Value>
+	template<typename Func>
+	void PerfectHashTable<Key, Value>::ForEach(Func&& func) const {
+		for (const auto& slot : slots) {
+			if (slot.key.Valid())
+				std::forward<Func>(func)(slot.key, slot.value);
+		}
+	}
+}
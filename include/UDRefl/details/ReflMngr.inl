@@ -43,29 +43,49 @@ namespace Ubpa::UDRefl::details {
 				static_assert(always_false<FuncPtr>);
 		}
 
+		// stateless Func (e.g. captureless lambda) decays to a function pointer,
+		// otherwise the wrapper is stored in MethodPtr (inline if small)
 		template<typename Func, size_t... Ns>
 		static /*constexpr*/ auto GenerateMemberFunction(Func&& func, std::index_sequence<Ns...>) noexcept {
-			using Traits = WrapFuncTraits<std::decay_t<Func>>;
+			using RawFunc = std::decay_t<Func>;
+			using Traits = WrapFuncTraits<RawFunc>;
 			using MaybeConstVoidPtr = std::conditional_t<Traits::is_const, const void*, void*>;
-			/*constexpr*/ auto wrapped_func =
-				[f = std::forward<Func>(func)](MaybeConstVoidPtr obj, void* result_buffer, ArgsView args) mutable -> Destructor {
+			if constexpr (std::is_empty_v<RawFunc> && std::is_default_constructible_v<RawFunc>) {
+				constexpr auto wrapped_func = [](MaybeConstVoidPtr obj, void* result_buffer, ArgsView args) -> Destructor {
+					assert(((args.GetParamList()[Ns] == TypeID_of<Args>)&&...));
+					auto wrapped_f = wrap_member_function(RawFunc{});
+					return wrapped_f(obj, result_buffer, args.GetBuffer());
+				};
+				return DecayLambda(wrapped_func);
+			}
+			else {
+				return [f = std::forward<Func>(func)](MaybeConstVoidPtr obj, void* result_buffer, ArgsView args) mutable -> Destructor {
 					assert(((args.GetParamList()[Ns] == TypeID_of<Args>)&&...));
 					auto wrapped_f = wrap_member_function(std::forward<Func>(f));
 					return wrapped_f(obj, result_buffer, args.GetBuffer());
 				};
-
-			return std::function{ wrapped_func };
+			}
 		}
 
+		// same as GenerateMemberFunction
 		template<typename Func, size_t... Ns>
 		static /*constexpr*/ auto GenerateStaticFunction(Func&& func, std::index_sequence<Ns...>) noexcept {
-			/*constexpr*/ auto wrapped_func =
-				[f = std::forward<Func>(func)](void* result_buffer, ArgsView args) mutable ->Destructor {
+			using RawFunc = std::decay_t<Func>;
+			if constexpr (std::is_empty_v<RawFunc> && std::is_default_constructible_v<RawFunc>) {
+				constexpr auto wrapped_func = [](void* result_buffer, ArgsView args) -> Destructor {
+					assert(((args.GetParamList()[Ns] == TypeID_of<Args>)&&...));
+					auto wrapped_f = wrap_static_function(RawFunc{});
+					return wrapped_f(result_buffer, args.GetBuffer());
+				};
+				return DecayLambda(wrapped_func);
+			}
+			else {
+				return [f = std::forward<Func>(func)](void* result_buffer, ArgsView args) mutable -> Destructor {
 					assert(((args.GetParamList()[Ns] == TypeID_of<Args>)&&...));
 					auto wrapped_f = wrap_static_function(std::forward<Func>(f));
 					return wrapped_f(result_buffer, args.GetBuffer());
 				};
-			return std::function{ wrapped_func };
+			}
 		}
 	};
 
@@ -478,9 +498,25 @@ namespace Ubpa::UDRefl::details {
 
 	template<typename T>
 	struct TypeAutoRegister : TypeAutoRegister_Default<T> {};
+
+	template<typename T>
+	struct TypeAutoRegister<Task<T>> {
+		static void run(ReflMngr& mngr) {
+			mngr.RegisterType<TaskBase>();
+			mngr.AddBases<Task<T>, TaskBase>();
+			mngr.RegisterType<T>();
+		}
+	};
 };
 
 namespace Ubpa::UDRefl {
+	//
+	// Freeze
+	///////////
+
+	inline ReflMngr::ReadGuard::ReadGuard() :
+		guard{ Instance().epochs } {}
+
 	//
 	// Factory
 	////////////
@@ -511,8 +547,8 @@ namespace Ubpa::UDRefl {
 			if constexpr (has_virtual_base_v<Object>) {
 				return {
 					TypeID_of<std::remove_const_t<Value>>,
-					field_offsetor<field_data>(),
-					ConstFlag{}
+					stateless_offset_function<decltype(field_offsetor<field_data>())>(),
+					ConstFlag::value
 				};
 			}
 			else {
@@ -551,10 +587,13 @@ namespace Ubpa::UDRefl {
 			tregistry.Register<Value>();
 			RegisterType<std::remove_const_t<Value>>();
 			if constexpr (has_virtual_base_v<Object>) {
+				auto offsetor = field_offsetor(data);
+				using Func = decltype(offsetor);
 				return {
 					TypeID_of<std::remove_const_t<Value>>,
-					field_offsetor(data),
-					ConstFlag{}
+					contextual_offset_function<Func>(),
+					std::make_shared<const Func>(std::move(offsetor)),
+					ConstFlag::value
 				};
 			}
 			else {
@@ -603,15 +642,30 @@ namespace Ubpa::UDRefl {
 			RegisterType<std::remove_const_t<Value>>();
 			using ConstFlag = std::bool_constant<std::is_const_v<Value>>;
 
-			auto offsetor = [f=std::forward<T>(data)](const void* obj) -> const void* {
-				return f(const_cast<Obj*>(reinterpret_cast<const Obj*>(obj)));
-			};
-
-			return {
-				TypeID_of<std::remove_const_t<Value>>,
-				offsetor,
-				ConstFlag{}
-			};
+			if constexpr (std::is_empty_v<RawT> && std::is_default_constructible_v<RawT>) {
+				// stateless: a function pointer, no context
+				auto offsetor = [](const void* obj) -> const void* {
+					return RawT{}(const_cast<Obj*>(reinterpret_cast<const Obj*>(obj)));
+				};
+				return {
+					TypeID_of<std::remove_const_t<Value>>,
+					stateless_offset_function<decltype(offsetor)>(),
+					ConstFlag::value
+				};
+			}
+			else {
+				// the functor is the context, out of line
+				auto offsetor = [f = std::forward<T>(data)](const void* obj) -> const void* {
+					return f(const_cast<Obj*>(reinterpret_cast<const Obj*>(obj)));
+				};
+				using Func = decltype(offsetor);
+				return {
+					TypeID_of<std::remove_const_t<Value>>,
+					contextual_offset_function<Func>(),
+					std::make_shared<const Func>(std::move(offsetor)),
+					ConstFlag::value
+				};
+			}
 		}
 	}
 
@@ -653,6 +707,8 @@ namespace Ubpa::UDRefl {
 			static_assert(!std::is_const_v<Return> && !std::is_volatile_v<Return> && !std::is_volatile_v<std::remove_reference_t<Return>>);
 			using U = std::conditional_t<std::is_reference_v<Return>, std::add_pointer_t<Return>, Return>;
 			tregistry.Register<Return>();
+			if constexpr (IsTask_v<Return>)
+				RegisterType<Return>(); // TaskBase, for InvokeCo
 			return {
 				TypeID_of<Return>,
 				sizeof(U),
@@ -668,7 +724,7 @@ namespace Ubpa::UDRefl {
 		if constexpr (sizeof...(Params) > 0) {
 			static_assert(((!std::is_const_v<Params> && !std::is_volatile_v<Params> && !std::is_volatile_v<std::remove_reference_t<Params>>)&&...));
 			(tregistry.Register<Params>(), ...);
-			return { { TypeID_of<Params>... } };
+			return { TypeID_of<Params>... };
 		}
 		else
 			return {};
@@ -746,9 +802,12 @@ namespace Ubpa::UDRefl {
 			else if constexpr (std::is_pointer_v<T>)
 				RegisterType<std::remove_cv_t<std::remove_pointer_t<T>>>();
 			else {
-				if (IsRegistered(TypeID_of<T>))
+				// publish the type and its inner types once
+				WriteGuard guard{ *this };
+				// the published tables lag behind <typeinfos> under the guard
+				if (typeinfos.contains(TypeID_of<T>))
 					return;
-				RegisterType(type_name<T>(), sizeof(T), alignof(T));
+				RegisterType(type_name<T>(), sizeof(T), alignof(T), TypeTraits::Of<T>());
 
 				if constexpr (std::is_default_constructible_v<T>)
 					AddConstructor<T>();
@@ -859,11 +918,21 @@ namespace Ubpa::UDRefl {
 
 	template<typename Derived, typename Base>
 	BaseInfo ReflMngr::GenerateBaseInfo() {
-		return {
-			inherit_cast_functions<Derived, Base>(),
-			std::is_polymorphic_v<Base>,
-			is_virtual_base_of_v<Base, Derived>
-		};
+		if constexpr (is_virtual_base_of_v<Base, Derived>) {
+			return {
+				inherit_cast_functions<Derived, Base>(),
+				std::is_polymorphic_v<Base>,
+				true
+			};
+		}
+		else {
+			return {
+				inherit_cast_functions<Derived, Base>(),
+				std::is_polymorphic_v<Base>,
+				false,
+				base_forward_offset_value<Derived, Base>()
+			};
+		}
 	}
 
 	template<typename Derived, typename... Bases>
@@ -887,6 +956,12 @@ namespace Ubpa::UDRefl {
 		return IsConstInvocable(typeID, methodID, std::span<const TypeID>{argTypeIDs});
 	}
 
+	template<typename... Args>
+	MethodHandle ReflMngr::ResolveMethod(TypeID typeID, StrID methodID, MethodSearchMode mode) const {
+		constexpr std::array argTypeIDs = { TypeID_of<Args>... };
+		return ResolveMethod(typeID, methodID, std::span<const TypeID>{argTypeIDs}, mode);
+	}
+
 	template<typename... Args>
 	InvocableResult ReflMngr::IsInvocable(TypeID typeID, StrID methodID) const {
 		constexpr std::array argTypeIDs = { TypeID_of<Args>... };
@@ -986,6 +1061,107 @@ namespace Ubpa::UDRefl {
 			return InvokeRet<T>(obj, methodID);
 	}
 
+
+	template<typename T>
+	std::optional<T> ReflMngr::TryInvokeRet(TypeID typeID, StrID methodID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+		static_assert(!std::is_void_v<T> && !std::is_reference_v<T>);
+		alignas(T) std::uint8_t result_buffer[sizeof(T)];
+		InvokeResult result = Invoke(typeID, methodID, result_buffer, argTypeIDs, args_buffer);
+		if (!result.success)
+			return std::nullopt;
+		assert(result.resultID == TypeID_of<T>);
+		return result.Move<T>(result_buffer);
+	}
+
+	template<typename T>
+	std::optional<T> ReflMngr::TryInvokeRet(ConstObjectPtr obj, StrID methodID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+		static_assert(!std::is_void_v<T> && !std::is_reference_v<T>);
+		alignas(T) std::uint8_t result_buffer[sizeof(T)];
+		InvokeResult result = Invoke(obj, methodID, result_buffer, argTypeIDs, args_buffer);
+		if (!result.success)
+			return std::nullopt;
+		assert(result.resultID == TypeID_of<T>);
+		return result.Move<T>(result_buffer);
+	}
+
+	template<typename T>
+	std::optional<T> ReflMngr::TryInvokeRet(ObjectPtr obj, StrID methodID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+		static_assert(!std::is_void_v<T> && !std::is_reference_v<T>);
+		alignas(T) std::uint8_t result_buffer[sizeof(T)];
+		InvokeResult result = Invoke(obj, methodID, result_buffer, argTypeIDs, args_buffer);
+		if (!result.success)
+			return std::nullopt;
+		assert(result.resultID == TypeID_of<T>);
+		return result.Move<T>(result_buffer);
+	}
+
+	template<typename T, typename... Args>
+	std::optional<T> ReflMngr::TryInvoke(TypeID typeID, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return TryInvokeRet<T>(typeID, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return TryInvokeRet<T>(typeID, methodID);
+	}
+
+	template<typename T, typename... Args>
+	std::optional<T> ReflMngr::TryInvoke(ConstObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return TryInvokeRet<T>(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return TryInvokeRet<T>(obj, methodID);
+	}
+
+	template<typename T, typename... Args>
+	std::optional<T> ReflMngr::TryInvoke(ObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return TryInvokeRet<T>(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return TryInvokeRet<T>(obj, methodID);
+	}
+
+	//
+	// Batch
+	//////////
+
+	template<typename... Args>
+	std::size_t ReflMngr::InvokeBatchArgs(std::span<const ObjectPtr> objs, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			const ArgsBuffer shared_args_buffer = args_buffer.data();
+			return InvokeBatch(objs, methodID, std::span<const TypeID>{ argTypeIDs }, std::span<const ArgsBuffer>{ &shared_args_buffer, 1 });
+		}
+		else
+			return InvokeBatch(objs, methodID);
+	}
+
+	//
+	// Array
+	//////////
+
+	template<typename T>
+	bool ReflMngr::Apply(StrID op, std::span<const T> lhs, std::span<const T> rhs, std::span<T> out) const {
+		if (lhs.size() != rhs.size() || lhs.size() != out.size())
+			return false;
+		return Apply(op, TypeID_of<T>, out.size(), out.data(), lhs.data(), rhs.data());
+	}
+
+	template<typename T>
+	bool ReflMngr::Apply(StrID op, std::span<T> lhs, std::span<const T> rhs) const {
+		if (lhs.size() != rhs.size())
+			return false;
+		return Apply(op, TypeID_of<T>, lhs.size(), lhs.data(), lhs.data(), rhs.data());
+	}
+
 	//
 	// Meta
 	/////////
@@ -1103,7 +1279,7 @@ namespace Ubpa::UDRefl {
 		StrID methodID,
 		Args&&... args) const
 	{
-		return MInvoke(typeID, methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return MInvoke(typeID, methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	template<typename... Args>
@@ -1112,7 +1288,7 @@ namespace Ubpa::UDRefl {
 		StrID methodID,
 		Args&&... args) const
 	{
-		return MInvoke(obj, methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return MInvoke(obj, methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	template<typename... Args>
@@ -1121,7 +1297,7 @@ namespace Ubpa::UDRefl {
 		StrID methodID,
 		Args&&... args) const
 	{
-		return MInvoke(obj, methodID, std::pmr::get_default_resource(), std::forward<Args>(args)...);
+		return MInvoke(obj, methodID, ScratchScope::ResultResource(), std::forward<Args>(args)...);
 	}
 
 	template<typename... Args>
@@ -1134,4 +1310,108 @@ namespace Ubpa::UDRefl {
 		else
 			return MNew(typeID, rsrc, std::span<const TypeID>{}, static_cast<ArgsBuffer>(nullptr));
 	}
+
+	//
+	// Async
+	//////////
+
+	template<typename... Args>
+	std::future<SharedObject> ReflMngr::InvokeAsync(TypeID typeID, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeAsync(typeID, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeAsync(typeID, methodID);
+	}
+
+	template<typename... Args>
+	std::future<SharedObject> ReflMngr::InvokeAsync(ConstObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeAsync(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeAsync(obj, methodID);
+	}
+
+	template<typename... Args>
+	std::future<SharedObject> ReflMngr::InvokeAsync(ObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeAsync(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeAsync(obj, methodID);
+	}
+
+	//
+	// Coroutine
+	//////////////
+
+	template<typename... Args>
+	Task<SharedObject> ReflMngr::InvokeCo(TypeID typeID, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeCo(typeID, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeCo(typeID, methodID);
+	}
+
+	template<typename... Args>
+	Task<SharedObject> ReflMngr::InvokeCo(ConstObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeCo(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeCo(obj, methodID);
+	}
+
+	template<typename... Args>
+	Task<SharedObject> ReflMngr::InvokeCo(ObjectPtr obj, StrID methodID, Args&&... args) const {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return MInvokeCo(obj, methodID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return MInvokeCo(obj, methodID);
+	}
+
+	//
+	// Algorithm
+	//////////////
+
+	template<typename T, typename Func, typename Reduce>
+	T ReflMngr::ParallelReduce(
+		std::span<const ObjectPtr> objs,
+		T init,
+		Func&& func,
+		Reduce&& reduce,
+		std::size_t grain) const
+	{
+		ThreadPool& pool = GetThreadPool();
+		if (grain == 0)
+			grain = pool.DefaultGrain(objs.size());
+
+		std::vector<std::optional<T>> partials(ThreadPool::NumChunks(objs.size(), grain));
+		pool.ParallelFor(objs.size(), grain, [&](std::size_t, std::size_t chunk, std::size_t begin, std::size_t end) {
+			T acc = init;
+			for (std::size_t i = begin; i < end; i++)
+				func(acc, objs[i]);
+			partials[chunk].emplace(std::move(acc));
+		});
+
+		T rst = std::move(init);
+		for (auto& partial : partials)
+			rst = reduce(std::move(rst), std::move(*partial));
+		return rst;
+	}
 }
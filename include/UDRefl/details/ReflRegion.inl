@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Ubpa::UDRefl {
+	template<typename... Args>
+	ObjectPtr ReflRegion::New(TypeID typeID, Args&&... args) {
+		if constexpr (sizeof...(Args) > 0) {
+			constexpr std::array argTypeIDs = { TypeID_of<decltype(args)>... };
+			const std::array args_buffer{ const_cast<void*>(reinterpret_cast<const void*>(&args))... };
+			return New(typeID, std::span<const TypeID>{ argTypeIDs }, static_cast<ArgsBuffer>(args_buffer.data()));
+		}
+		else
+			return New(typeID, std::span<const TypeID>{}, static_cast<ArgsBuffer>(nullptr));
+	}
+}
@@ -0,0 +1,9 @@
+#include "ArrayKernelImpl.h"
+#include <vector>
+#include <cstdio>
+using namespace Ubpa::UDRefl;
+int main(){ std::vector<float> a(1027,3.f), b(1027,2.f), c(1027);
+ auto k = FindArrayKernel(StrIDRegistry::MetaID::operator_mul, TypeID_of<float>); k(c.data(),a.data(),b.data(),c.size());
+ std::vector<std::uint8_t> x(100,200), y(100,100); FindArrayKernel(StrIDRegistry::MetaID::operator_assign_add, TypeID_of<std::uint8_t>)(x.data(),x.data(),y.data(),100);
+ std::printf("%g %d %d %d\n", c[1026], x[5], FindArrayKernel(StrID{99}, TypeID_of<float>)==nullptr, FindArrayKernel(StrIDRegistry::MetaID::operator_add, TypeID_of<char>)==nullptr);
+ std::printf("avx2 table used: %d\n", k == details::array_kernels_avx2[0][2]); }
@@ -0,0 +1,85 @@
+#include <UDRefl/ArgumentConversionPlan.h>
+
+#include <cstring>
+
+using namespace Ubpa::UDRefl;
+
+ArgumentConversionPlan::ArgumentConversionPlan(std::size_t num_args) noexcept :
+	num_args{ num_args },
+	scratch_size{ num_args * sizeof(void*) }
+{}
+
+std::size_t ArgumentConversionPlan::Allocate(std::size_t size, std::size_t alignment) noexcept {
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	const std::size_t offset = (scratch_size + alignment - 1) & ~(alignment - 1);
+	scratch_size = offset + size;
+	if (alignment > scratch_alignment)
+		scratch_alignment = alignment;
+	return offset;
+}
+
+void ArgumentConversionPlan::AddCopyPointer(std::size_t index) {
+	assert(index < num_args);
+	steps.push_back({ StepKind::CopyPointer, index, Allocate(sizeof(void*), alignof(void*)) });
+}
+
+void ArgumentConversionPlan::AddCopy(std::size_t index, std::size_t size, std::size_t alignment) {
+	assert(index < num_args);
+	steps.push_back({ StepKind::Copy, index, Allocate(size, alignment), size });
+}
+
+void ArgumentConversionPlan::AddConstruct(
+	std::size_t index,
+	std::size_t size,
+	std::size_t alignment,
+	const MethodPtr& ctor,
+	const MethodPtr* dtor)
+{
+	assert(index < num_args);
+	assert(ctor.IsMemberVariable());
+	assert(!dtor || dtor->IsMemberConst());
+	steps.push_back({ StepKind::Construct, index, Allocate(size, alignment), size, &ctor, dtor });
+}
+
+ArgsBuffer ArgumentConversionPlan::Apply(void* scratch, ArgsBuffer args_buffer) const {
+	assert(scratch);
+	auto* bytes = static_cast<std::uint8_t*>(scratch);
+	auto* args = static_cast<void**>(scratch);
+
+	for (std::size_t i = 0; i < num_args; i++)
+		args[i] = args_buffer[i];
+
+	for (const auto& step : steps) {
+		void* temporary = bytes + step.offset;
+		switch (step.kind)
+		{
+		case StepKind::CopyPointer:
+			*static_cast<void**>(temporary) = *static_cast<void* const*>(args_buffer[step.index]);
+			break;
+		case StepKind::Copy:
+			std::memcpy(temporary, args_buffer[step.index], step.size);
+			break;
+		case StepKind::Construct:
+			// the ctor's parameter binds the argument directly
+			step.ctor->Invoke(temporary, nullptr, args_buffer + step.index);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+		args[step.index] = temporary;
+	}
+
+	return args;
+}
+
+void ArgumentConversionPlan::Release(void* scratch) const noexcept {
+	assert(scratch);
+	auto* bytes = static_cast<std::uint8_t*>(scratch);
+
+	for (auto iter = steps.rbegin(); iter != steps.rend(); ++iter) {
+		if (iter->kind != StepKind::Construct || !iter->dtor)
+			continue;
+		iter->dtor->Invoke(static_cast<const void*>(bytes + iter->offset), nullptr, nullptr);
+	}
+}
@@ -0,0 +1,84 @@
+#include "ArrayKernelImpl.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace {
+	struct Baseline {};
+}
+
+namespace Ubpa::UDRefl::details {
+	constexpr ArrayKernelTable array_kernels = MakeArrayKernelTable<Baseline>();
+
+	// the order of MakeArrayKernelTable, NumArrayTypes if no kernel
+	static std::size_t ArrayTypeIndex(TypeID typeID) noexcept {
+		const TypeID typeIDs[NumArrayTypes] = {
+			TypeID_of<float>, TypeID_of<double>,
+			TypeID_of<std::int32_t>, TypeID_of<std::int64_t>, TypeID_of<std::uint32_t>, TypeID_of<std::uint64_t>,
+			TypeID_of<std::int8_t>, TypeID_of<std::int16_t>, TypeID_of<std::uint8_t>, TypeID_of<std::uint16_t>
+		};
+		std::size_t i = 0;
+		while (i < NumArrayTypes && typeIDs[i] != typeID)
+			++i;
+		return i;
+	}
+
+	// the order of ArrayOp, NumArrayOps if no kernel
+	static std::size_t ArrayOpIndex(StrID op) noexcept {
+		if (op == StrIDRegistry::MetaID::operator_add || op == StrIDRegistry::MetaID::operator_assign_add)
+			return static_cast<std::size_t>(ArrayOp::Add);
+		if (op == StrIDRegistry::MetaID::operator_sub || op == StrIDRegistry::MetaID::operator_assign_sub)
+			return static_cast<std::size_t>(ArrayOp::Sub);
+		if (op == StrIDRegistry::MetaID::operator_mul || op == StrIDRegistry::MetaID::operator_assign_mul)
+			return static_cast<std::size_t>(ArrayOp::Mul);
+		if (op == StrIDRegistry::MetaID::operator_div || op == StrIDRegistry::MetaID::operator_assign_div)
+			return static_cast<std::size_t>(ArrayOp::Div);
+		return NumArrayOps;
+	}
+
+#if defined(__x86_64__) || defined(_M_X64)
+	// the CPU and the OS (YMM state) support AVX2
+	static bool HasAVX2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	static const ArrayKernelTable& SelectArrayKernels() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+		if (HasAVX2())
+			return array_kernels_avx2;
+#endif
+		return array_kernels;
+	}
+}
+
+ArrayKernel Ubpa::UDRefl::FindArrayKernel(StrID op, TypeID typeID) noexcept {
+	const std::size_t type_index = details::ArrayTypeIndex(typeID);
+	const std::size_t op_index = details::ArrayOpIndex(op);
+	if (type_index == details::NumArrayTypes || op_index == details::NumArrayOps)
+		return nullptr;
+
+	static const details::ArrayKernelTable& kernels = details::SelectArrayKernels();
+	return kernels[type_index][op_index];
+}
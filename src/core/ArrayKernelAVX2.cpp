@@ -0,0 +1,14 @@
+#include "ArrayKernelImpl.h"
+
+// compiled with -mavx2 or /arch:AVX2 on x86-64 (src/core/CMakeLists.txt)
+// - the table is constant-initialized, nothing here runs before the CPU is checked
+
+#if defined(__x86_64__) || defined(_M_X64)
+namespace {
+	struct AVX2 {};
+}
+
+namespace Ubpa::UDRefl::details {
+	constinit const ArrayKernelTable array_kernels_avx2 = MakeArrayKernelTable<AVX2>();
+}
+#endif
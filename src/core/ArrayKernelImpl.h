@@ -0,0 +1,65 @@
+#pragma once
+
+#include <UDRefl/ArrayKernel.h>
+
+#include <array>
+
+namespace Ubpa::UDRefl::details {
+	enum class ArrayOp : std::uint8_t { Add, Sub, Mul, Div };
+
+	constexpr std::size_t NumArrayOps = 4;
+	constexpr std::size_t NumArrayTypes = 10;
+
+	// [type][op], the order of ArrayTypeIndex and ArrayOpIndex (ArrayKernel.cpp)
+	using ArrayKernelTable = std::array<std::array<ArrayKernel, NumArrayOps>, NumArrayTypes>;
+
+	// ISA: a tag of the translation unit (anonymous namespace), so each instruction set
+	// gets its own instantiations, and the loop calls no function shared between them
+	template<typename ISA, typename T, ArrayOp op>
+	void ArrayKernelImpl(void* out, const void* lhs, const void* rhs, std::size_t count) noexcept {
+		T* o = static_cast<T*>(out);
+		const T* l = static_cast<const T*>(lhs);
+		const T* r = static_cast<const T*>(rhs);
+		for (std::size_t i = 0; i < count; i++) {
+			if constexpr (op == ArrayOp::Add)
+				o[i] = static_cast<T>(l[i] + r[i]);
+			else if constexpr (op == ArrayOp::Sub)
+				o[i] = static_cast<T>(l[i] - r[i]);
+			else if constexpr (op == ArrayOp::Mul)
+				o[i] = static_cast<T>(l[i] * r[i]);
+			else
+				o[i] = static_cast<T>(l[i] / r[i]);
+		}
+	}
+
+	template<typename ISA, typename T>
+	constexpr std::array<ArrayKernel, NumArrayOps> MakeArrayKernels() noexcept {
+		return {
+			&ArrayKernelImpl<ISA, T, ArrayOp::Add>,
+			&ArrayKernelImpl<ISA, T, ArrayOp::Sub>,
+			&ArrayKernelImpl<ISA, T, ArrayOp::Mul>,
+			&ArrayKernelImpl<ISA, T, ArrayOp::Div>
+		};
+	}
+
+	template<typename ISA>
+	constexpr ArrayKernelTable MakeArrayKernelTable() noexcept {
+		return {
+			MakeArrayKernels<ISA, float>(),
+			MakeArrayKernels<ISA, double>(),
+			MakeArrayKernels<ISA, std::int32_t>(),
+			MakeArrayKernels<ISA, std::int64_t>(),
+			MakeArrayKernels<ISA, std::uint32_t>(),
+			MakeArrayKernels<ISA, std::uint64_t>(),
+			MakeArrayKernels<ISA, std::int8_t>(),
+			MakeArrayKernels<ISA, std::int16_t>(),
+			MakeArrayKernels<ISA, std::uint8_t>(),
+			MakeArrayKernels<ISA, std::uint16_t>()
+		};
+	}
+
+#if defined(__x86_64__) || defined(_M_X64)
+	// ArrayKernelAVX2.cpp, compiled with AVX2 enabled, used only if the CPU supports it
+	extern const ArrayKernelTable array_kernels_avx2;
+#endif
+}
@@ -0,0 +1,152 @@
+#include <UDRefl/EpochDomain.h>
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+//
+// ReadGuard
+//////////////
+
+EpochDomain::ReadGuard::ReadGuard(const EpochDomain& domain) {
+	slot = domain.AcquireSlot(owned);
+
+	// the pin is ordered before the reader's loads of published pointers (seq_cst),
+	// so a writer retiring after those loads sees it
+	if (slot->depth++ == 0)
+		slot->epoch.store(domain.global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+EpochDomain::ReadGuard::~ReadGuard() {
+	if (--slot->depth == 0) {
+		slot->epoch.store(Idle, std::memory_order_release);
+		if (owned)
+			slot->in_use.store(false, std::memory_order_release);
+	}
+}
+
+//
+// EpochDomain
+////////////////
+
+EpochDomain::~EpochDomain() {
+	Slot* slot = slots.load(std::memory_order_acquire);
+	while (slot) {
+		assert(slot->depth == 0);
+		Slot* next = slot->next;
+		delete slot;
+		slot = next;
+	}
+}
+
+EpochDomain::Slot* EpochDomain::AcquireSlot(bool& owned) const {
+	// trivially destructible, so it stays usable while the thread's other thread_locals are destroyed
+	struct SlotCache {
+		const EpochDomain* domain;
+		Slot* slot;
+	};
+	thread_local SlotCache cache{ nullptr, nullptr };
+
+	// gives the cached slot back when the thread exits
+	struct SlotRelease {
+		~SlotRelease() {
+			if (cache.slot)
+				cache.slot->in_use.store(false, std::memory_order_release);
+			cache = { nullptr, nullptr };
+		}
+	};
+	thread_local SlotRelease release;
+
+	if (cache.domain == this) {
+		owned = false;
+		return cache.slot;
+	}
+
+	Slot* slot = nullptr;
+
+	// reuse the slot of an exited thread
+	for (Slot* iter = slots.load(std::memory_order_acquire); iter; iter = iter->next) {
+		bool expected = false;
+		if (!iter->in_use.load(std::memory_order_relaxed)
+			&& iter->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+		{
+			slot = iter;
+			break;
+		}
+	}
+
+	if (!slot) {
+		slot = new Slot;
+		slot->in_use.store(true, std::memory_order_relaxed);
+		Slot* head = slots.load(std::memory_order_relaxed);
+		do {
+			slot->next = head;
+		} while (!slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// one domain per thread is cached, the slots of the others go back with their guard
+	if (!cache.domain) {
+		static_cast<void>(&release); // registers its destructor
+		cache = { this, slot };
+		owned = false;
+	}
+	else
+		owned = true;
+
+	return slot;
+}
+
+std::uint64_t EpochDomain::MinPinnedEpoch() const noexcept {
+	std::uint64_t min_epoch = Idle;
+	for (Slot* slot = slots.load(std::memory_order_acquire); slot; slot = slot->next)
+		min_epoch = std::min(min_epoch, slot->epoch.load(std::memory_order_seq_cst));
+	return min_epoch;
+}
+
+void EpochDomain::Retire(std::shared_ptr<const void> object) {
+	if (!object)
+		return;
+
+	// readers pinned at an epoch after <epoch> entered after the unpublication
+	const std::uint64_t epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+	std::lock_guard lock{ retired_mutex };
+	retired.push_back({ epoch, std::move(object) });
+}
+
+void EpochDomain::Collect() {
+	std::vector<Retired> released;
+
+	{
+		std::lock_guard lock{ retired_mutex };
+		if (retired.empty())
+			return;
+
+		const std::uint64_t min_epoch = MinPinnedEpoch();
+		auto iter = std::partition(retired.begin(), retired.end(), [min_epoch](const Retired& item) {
+			return item.epoch >= min_epoch;
+		});
+		released.assign(std::make_move_iterator(iter), std::make_move_iterator(retired.end()));
+		retired.erase(iter, retired.end());
+	}
+
+	// destructors run out of the lock
+}
+
+void EpochDomain::Synchronize() {
+	// a reader re-entering pins a newer epoch, so the retired ones drain
+	while (true) {
+		Collect();
+		if (NumRetired() == 0)
+			return;
+		std::this_thread::yield();
+	}
+}
+
+std::size_t EpochDomain::NumRetired() const {
+	std::lock_guard lock{ retired_mutex };
+	return retired.size();
+}
@@ -0,0 +1,33 @@
+#include <UDRefl/FieldHandle.h>
+
+using namespace Ubpa::UDRefl;
+
+FieldHandle::FieldHandle(TypeID typeID, const FieldInfo& fieldinfo, std::size_t offset, std::vector<const BaseInfo*> path) :
+	typeID{ typeID },
+	// the nodes of ReflMngr::typeinfos are mutable, for FieldPtr::RWVar
+	fieldptr{ const_cast<FieldPtr*>(&fieldinfo.fieldptr) },
+	offset{ offset },
+	path{ std::move(path) }
+{}
+
+const void* FieldHandle::StaticCast_DerivedToFieldType(const void* obj) const noexcept {
+	if (!obj)
+		return nullptr;
+
+	obj = forward_offset(obj, offset);
+	for (const BaseInfo* baseinfo : path)
+		obj = baseinfo->StaticCast_DerivedToBase(obj);
+	return obj;
+}
+
+ConstObjectPtr FieldHandle::RVar(const void* obj) const {
+	assert(Valid());
+	return fieldptr->RVar(StaticCast_DerivedToFieldType(obj));
+}
+
+ObjectPtr FieldHandle::RWVar(void* obj) const {
+	assert(Valid());
+	if (!fieldptr->IsVariable())
+		return nullptr;
+	return fieldptr->RWVar(const_cast<void*>(StaticCast_DerivedToFieldType(obj)));
+}
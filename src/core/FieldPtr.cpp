@@ -3,147 +3,96 @@
 using namespace Ubpa::UDRefl;
 
 FieldPtr::FieldPtr(TypeID valueID, size_t forward_offset_value, bool isConst) noexcept :
-	valueID{ valueID }
+	valueID{ valueID },
+	kind{ isConst ? Kind::BasicConst : Kind::BasicVariable },
+	forward_offset_value{ forward_offset_value }
 {
 	assert(valueID);
+}
 
-	if (isConst)
-		data.emplace<1>(forward_offset_value);
-	else
-		data.emplace<0>(forward_offset_value);
+FieldPtr::FieldPtr(TypeID valueID, Offsetor offsetor, bool isConst) :
+	FieldPtr{
+		valueID,
+		contextual_offset_function<Offsetor>(),
+		std::make_shared<const Offsetor>(std::move(offsetor)),
+		isConst
+	}
+{
+	assert(*reinterpret_cast<const Offsetor*>(storage.get()));
 }
 
-FieldPtr::FieldPtr(TypeID valueID, const Buffer& buffer, bool isConst) noexcept :
-	valueID{ valueID }
+FieldPtr::FieldPtr(TypeID valueID, const Buffer& buffer, bool isConst) :
+	valueID{ valueID },
+	kind{ isConst ? Kind::DynamicBufferConst : Kind::DynamicBufferVariable },
+	storage{ std::make_shared<Buffer>(buffer) }
 {
 	assert(valueID);
-
-	if (isConst)
-		data.emplace<9>(buffer);
-	else
-		data.emplace<8>(buffer);
 }
 
 ConstObjectPtr FieldPtr::RVar() const {
-	return std::visit([this](const auto& value) -> ConstObjectPtr {
-		using T = std::decay_t<decltype(value)>;
-		if constexpr (std::is_same_v<T, size_t>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, Offsetor>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, void*>) {
-			return { valueID, value };
-		}
-		else if constexpr (std::is_same_v<T, const void*>) {
-			return { valueID, value };
-		}
-		else if constexpr (std::is_same_v<T, SharedBuffer>) {
-			return { valueID, value.get() };
-		}
-		else if constexpr (std::is_same_v<T, SharedConstBuffer>) {
-			return { valueID, value.get() };
-		}
-		else if constexpr (std::is_same_v<T, Buffer>) {
-			return { valueID, &value };
-		}
-		/*else if constexpr (std::is_same_v<T, const Buffer>) {
-			return { valueID, &value };
-		}*/
-		else
-			static_assert(always_false<T>);
-	}, data);
+	switch (kind)
+	{
+	case Kind::StaticVariable:
+	case Kind::StaticConst:
+		return { valueID, static_obj };
+	case Kind::DynamicSharedVariable:
+	case Kind::DynamicSharedConst:
+	case Kind::DynamicBufferVariable:
+	case Kind::DynamicBufferConst:
+		return { valueID, storage.get() };
+	default:
+		assert("require unowned" && false);
+		return nullptr;
+	}
 }
 
 ObjectPtr FieldPtr::RWVar() {
-	return std::visit([this](auto& value) -> ObjectPtr {
-		using T = std::remove_reference_t<decltype(value)>;
-		if constexpr (std::is_same_v<T, size_t>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, Offsetor>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, void*>) {
-			return { valueID, value };
-		}
-		else if constexpr (std::is_same_v<T, const void*>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, SharedBuffer>) {
-			return { valueID, value.get() };
-		}
-		else if constexpr (std::is_same_v<T, SharedConstBuffer>) {
-			assert(false);
-			return nullptr;
-		}
-		else if constexpr (std::is_same_v<T, Buffer>) {
-			return { valueID, &value };
-		}
-		else if constexpr (std::is_same_v<T, const Buffer>) {
-			assert(false);
-			return nullptr;
-		}
-		else
-			static_assert(always_false<T>);
-	}, data);
+	switch (kind)
+	{
+	case Kind::StaticVariable:
+		return { valueID, static_obj };
+	case Kind::DynamicSharedVariable:
+	case Kind::DynamicBufferVariable:
+		return { valueID, storage.get() };
+	default:
+		assert("require unowned variable" && false);
+		return nullptr;
+	}
 }
 
 ConstObjectPtr FieldPtr::RVar(const void* obj) const {
-	return std::visit([this, obj](const auto& value) -> ConstObjectPtr {
-		using T = std::decay_t<decltype(value)>;
-		if constexpr (std::is_same_v<T, size_t>) {
-			assert(obj);
-			return { valueID, forward_offset(obj, value) };
-		}
-		else if constexpr (std::is_same_v<T, Offsetor>) {
-			assert(obj);
-			return { valueID, value(obj) };
-		}
-		else if constexpr (std::is_same_v<T, void*>) {
-			return { valueID, value };
-		}
-		else if constexpr (std::is_same_v<T, const void*>) {
-			return { valueID, value };
-		}
-		else if constexpr (std::is_same_v<T, SharedBuffer>) {
-			return { valueID, value.get() };
-		}
-		else if constexpr (std::is_same_v<T, SharedConstBuffer>) {
-			return { valueID, value.get() };
-		}
-		else if constexpr (std::is_same_v<T, Buffer>) {
-			return { valueID, &value };
-		}
-		/*else if constexpr (std::is_same_v<T, const Buffer>) {
-			return { valueID, &value };
-		}*/
-		else
-			static_assert(always_false<T>);
-	}, data);
+	switch (kind)
+	{
+	case Kind::BasicVariable:
+	case Kind::BasicConst:
+		assert(obj);
+		return { valueID, forward_offset(obj, forward_offset_value) };
+	case Kind::VirtualVariable:
+	case Kind::VirtualConst:
+		assert(obj);
+		return { valueID, offsetor(obj, storage.get()) };
+	case Kind::StaticVariable:
+	case Kind::StaticConst:
+		return { valueID, static_obj };
+	default: // dynamic
+		return { valueID, storage.get() };
+	}
 }
 
 ObjectPtr FieldPtr::RWVar(void* obj) noexcept {
-	switch (data.index())
+	switch (kind)
 	{
-	case 0:
+	case Kind::BasicVariable:
 		assert(obj);
-		return { valueID, forward_offset(obj, std::get<0>(data)) };
-	case 2:
+		return { valueID, forward_offset(obj, forward_offset_value) };
+	case Kind::VirtualVariable:
 		assert(obj);
-		return { valueID, const_cast<void*>(std::get<2>(data)(obj)) };
-	case 4:
-		return { valueID, std::get<4>(data) };
-	case 6:
-		return { valueID, std::get<6>(data).get() };
-	case 8:
-		return { valueID, &std::get<8>(data) };
+		return { valueID, const_cast<void*>(offsetor(obj, storage.get())) };
+	case Kind::StaticVariable:
+		return { valueID, static_obj };
+	case Kind::DynamicSharedVariable:
+	case Kind::DynamicBufferVariable:
+		return { valueID, storage.get() };
 	default:
 		assert("require variable" && false);
 		return nullptr;
@@ -0,0 +1,193 @@
+#include <UDRefl/FrozenRegistry.h>
+
+#include <UDRefl/CastPathCache.h>
+
+#include <set>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	// FlatMethod before FrozenRegistry::paths stops growing
+	struct FlatMethodItem {
+		const MethodInfo* methodinfo;
+		std::size_t path_offset;
+		std::size_t path_size;
+	};
+
+	// FlatField before FrozenRegistry::paths stops growing
+	struct FlatFieldItem {
+		const FieldInfo* fieldinfo;
+		std::size_t offset;
+		std::size_t path_offset;
+		std::size_t path_size;
+	};
+
+	using FlatMethodItems = std::unordered_map<StrID, std::vector<FlatMethodItem>>;
+	using FlatFieldItems = std::unordered_map<StrID, std::vector<FlatFieldItem>>;
+
+	// depth-first, in the order of ReflMngr's overload resolution and field lookup
+	static void CollectFlatMembers(
+		const std::unordered_map<TypeID, TypeInfo>& typeinfos,
+		TypeID typeID,
+		std::vector<const BaseInfo*>& path,
+		std::set<TypeID>& visited,
+		std::vector<const BaseInfo*>& paths,
+		FlatMethodItems& method_items,
+		FlatFieldItems& field_items)
+	{
+		if (!visited.insert(typeID).second)
+			return;
+
+		auto target = typeinfos.find(typeID);
+		if (target == typeinfos.end())
+			return;
+
+		const TypeInfo& typeinfo = target->second;
+
+		if (!typeinfo.methodinfos.empty()) {
+			const std::size_t path_offset = paths.size();
+			paths.insert(paths.end(), path.begin(), path.end());
+			for (const auto& [methodID, methodinfo] : typeinfo.methodinfos)
+				method_items[methodID].push_back({ &methodinfo, path_offset, path.size() });
+		}
+
+		if (!typeinfo.fieldinfos.empty()) {
+			// bases with an offset fold into a constant one
+			std::size_t offset = 0;
+			const std::size_t num_folded = CastPath::FoldOffsetPrefix(path, offset);
+
+			const std::size_t path_offset = paths.size();
+			paths.insert(paths.end(), path.begin() + num_folded, path.end());
+			const std::size_t path_size = paths.size() - path_offset;
+			for (const auto& [fieldID, fieldinfo] : typeinfo.fieldinfos)
+				field_items[fieldID].push_back({ &fieldinfo, offset, path_offset, path_size });
+		}
+
+		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+			path.push_back(&baseinfo);
+			CollectFlatMembers(typeinfos, baseID, path, visited, paths, method_items, field_items);
+			path.pop_back();
+		}
+	}
+}
+
+bool FrozenRegistry::Build(const std::unordered_map<TypeID, TypeInfo>& typeinfos) {
+	Clear();
+
+	bool success = true;
+
+	// spans refer to <ordered_fields>, <ordered_methods>, <methods> and <bases>, so they must not reallocate
+	std::size_t num_fields = 0;
+	std::size_t num_methods = 0;
+	std::size_t num_bases = 0;
+	for (const auto& [typeID, typeinfo] : typeinfos) {
+		num_fields += typeinfo.fieldinfos.size();
+		num_methods += typeinfo.methodinfos.size();
+		num_bases += typeinfo.baseinfos.size();
+	}
+	ordered_fields.reserve(num_fields);
+	ordered_methods.reserve(num_methods);
+	methods.reserve(num_methods);
+	bases.reserve(num_bases);
+
+	std::vector<std::pair<TypeID, FrozenTypeInfo>> type_items;
+	type_items.reserve(typeinfos.size());
+
+	std::vector<details::FlatMethodItems> flat_method_items;
+	std::vector<details::FlatFieldItems> flat_field_items;
+	flat_method_items.reserve(typeinfos.size());
+	flat_field_items.reserve(typeinfos.size());
+	std::size_t num_flat_methods = 0;
+	std::size_t num_flat_fields = 0;
+
+	for (const auto& [typeID, typeinfo] : typeinfos) {
+		FrozenTypeInfo ftypeinfo;
+		ftypeinfo.typeinfo = &typeinfo;
+		ftypeinfo.pool = typeinfo.pool;
+		ftypeinfo.shared_pool = typeinfo.shared_pool;
+
+		const std::size_t field_offset = ordered_fields.size();
+		for (const auto& [fieldID, fieldinfo] : typeinfo.fieldinfos)
+			ordered_fields.emplace_back(fieldID, &fieldinfo);
+		ftypeinfo.ordered_fieldinfos = { ordered_fields.data() + field_offset, ordered_fields.size() - field_offset };
+		success &= ftypeinfo.fieldinfos.Build(std::vector<std::pair<StrID, const FieldInfo*>>(
+			ftypeinfo.ordered_fieldinfos.begin(), ftypeinfo.ordered_fieldinfos.end()));
+
+		const std::size_t method_offset = ordered_methods.size();
+		for (const auto& [methodID, methodinfo] : typeinfo.methodinfos)
+			ordered_methods.emplace_back(methodID, &methodinfo);
+		ftypeinfo.ordered_methodinfos = { ordered_methods.data() + method_offset, ordered_methods.size() - method_offset };
+
+		// overloads with the same StrID are adjacent in an unordered_multimap
+		std::vector<std::pair<StrID, std::span<const MethodInfo* const>>> method_items;
+		auto miter = typeinfo.methodinfos.begin();
+		while (miter != typeinfo.methodinfos.end()) {
+			const StrID methodID = miter->first;
+			const std::size_t offset = methods.size();
+			for (; miter != typeinfo.methodinfos.end() && miter->first == methodID; ++miter)
+				methods.push_back(&miter->second);
+			method_items.emplace_back(methodID, std::span<const MethodInfo* const>{ methods.data() + offset, methods.size() - offset });
+		}
+		success &= ftypeinfo.methodinfos.Build(std::move(method_items));
+
+		const std::size_t base_offset = bases.size();
+		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos)
+			bases.emplace_back(baseID, &baseinfo);
+		ftypeinfo.baseinfos = { bases.data() + base_offset, bases.size() - base_offset };
+
+		type_items.emplace_back(typeID, std::move(ftypeinfo));
+
+		std::vector<const BaseInfo*> path;
+		std::set<TypeID> visited;
+		auto& type_method_items = flat_method_items.emplace_back();
+		auto& type_field_items = flat_field_items.emplace_back();
+		details::CollectFlatMembers(typeinfos, typeID, path, visited, paths, type_method_items, type_field_items);
+		for (const auto& [methodID, overloads] : type_method_items)
+			num_flat_methods += overloads.size();
+		for (const auto& [fieldID, fields] : type_field_items)
+			num_flat_fields += fields.size();
+	}
+
+	// spans refer to <flat_methods>, <flat_fields> and <paths>, so they must not reallocate
+	flat_methods.reserve(num_flat_methods);
+	flat_fields.reserve(num_flat_fields);
+	for (std::size_t i = 0; i < type_items.size(); i++) {
+		std::vector<std::pair<StrID, std::span<const FlatMethod>>> method_items;
+		method_items.reserve(flat_method_items[i].size());
+		for (const auto& [methodID, overloads] : flat_method_items[i]) {
+			const std::size_t offset = flat_methods.size();
+			for (const auto& item : overloads)
+				flat_methods.push_back({ item.methodinfo, { paths.data() + item.path_offset, item.path_size } });
+			method_items.emplace_back(methodID, std::span<const FlatMethod>{ flat_methods.data() + offset, overloads.size() });
+		}
+		success &= type_items[i].second.flat_methodinfos.Build(std::move(method_items));
+
+		std::vector<std::pair<StrID, std::span<const FlatField>>> field_items;
+		field_items.reserve(flat_field_items[i].size());
+		for (const auto& [fieldID, fields] : flat_field_items[i]) {
+			const std::size_t offset = flat_fields.size();
+			for (const auto& item : fields)
+				flat_fields.push_back({ item.fieldinfo, item.offset, { paths.data() + item.path_offset, item.path_size } });
+			field_items.emplace_back(fieldID, std::span<const FlatField>{ flat_fields.data() + offset, fields.size() });
+		}
+		success &= type_items[i].second.flat_fieldinfos.Build(std::move(field_items));
+	}
+
+	success &= types.Build(std::move(type_items));
+
+	if (!success)
+		Clear();
+	return success;
+}
+
+void FrozenRegistry::Clear() noexcept {
+	types.Clear();
+	ordered_fields.clear();
+	ordered_methods.clear();
+	methods.clear();
+	bases.clear();
+	flat_methods.clear();
+	flat_fields.clear();
+	paths.clear();
+}
@@ -138,7 +138,9 @@ void TypeIDRegistry::RegisterUnmanaged(TypeID ID, std::string_view name) {
 		return;
 	}
 
-	IDRegistry<TypeID>::RegisterUnmanaged(ID, name);
+	std::unique_lock lock{ mutex };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(ID, name);
+	RegisterShape(ID, name);
 }
 
 TypeID TypeIDRegistry::RegisterUnmanaged(std::string_view name) {
@@ -147,7 +149,11 @@ TypeID TypeIDRegistry::RegisterUnmanaged(std::string_view name) {
 		return {};
 	}
 
-	return IDRegistry<TypeID>::RegisterUnmanaged(name);
+	TypeID ID{ name };
+	std::unique_lock lock{ mutex };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(ID, name);
+	RegisterShape(ID, name);
+	return ID;
 }
 
 void TypeIDRegistry::Register(TypeID ID, std::string_view name) {
@@ -156,7 +162,9 @@ void TypeIDRegistry::Register(TypeID ID, std::string_view name) {
 		return;
 	}
 
-	IDRegistry<TypeID>::Register(ID, name);
+	std::unique_lock lock{ mutex };
+	IDRegistry<TypeID>::Register_Unlocked(ID, name);
+	RegisterShape(ID, name);
 }
 
 TypeID TypeIDRegistry::Register(std::string_view name) {
@@ -165,7 +173,74 @@ TypeID TypeIDRegistry::Register(std::string_view name) {
 		return {};
 	}
 
-	return IDRegistry<TypeID>::Register(name);
+	TypeID ID{ name };
+	std::unique_lock lock{ mutex };
+	IDRegistry<TypeID>::Register_Unlocked(ID, name);
+	RegisterShape(ID, name);
+	return ID;
+}
+
+const TypeIDRegistry::TypeShape* TypeIDRegistry::GetShape(TypeID ID) const noexcept {
+	return id2shape.Find(ID);
+}
+
+void TypeIDRegistry::UnregisterUnmanaged(TypeID ID) {
+	// readers may still point to the shape
+	IDRegistry<TypeID>::UnregisterUnmanaged(ID);
+}
+
+void TypeIDRegistry::Clear() noexcept {
+	{
+		std::unique_lock lock{ mutex };
+		id2shape.Clear();
+	}
+	IDRegistry<TypeID>::Clear();
+}
+
+#ifndef NDEBUG
+void TypeIDRegistry::ClearUnmanaged() noexcept {
+	// the shapes are kept, see UnregisterUnmanaged
+	IDRegistry<TypeID>::ClearUnmanaged();
+}
+#endif // !NDEBUG
+
+void TypeIDRegistry::RegisterShape(TypeID ID, std::string_view name) {
+	if (id2shape.Find(ID))
+		return;
+
+	TypeShape shape;
+
+	std::string_view referee = name;
+	if (type_name_is_lvalue_reference(name)) {
+		shape.reference = TypeShape::Reference::LValue;
+		referee = type_name_remove_reference(name);
+	}
+	else if (type_name_is_rvalue_reference(name)) {
+		shape.reference = TypeShape::Reference::RValue;
+		referee = type_name_remove_reference(name);
+	}
+
+	assert(!type_name_is_volatile(referee));
+	shape.is_const = type_name_is_const(referee);
+	shape.is_pointer = type_name_is_pointer(name);
+
+	std::string_view raw = type_name_remove_const(referee);
+
+	if (shape.IsReference()) {
+		shape.referee = TypeID{ referee };
+		shape.raw = TypeID{ raw };
+	}
+	else {
+		shape.referee = ID;
+		shape.raw = ID;
+	}
+
+	shape.lref = TypeID{ type_name_add_lvalue_reference_hash(raw) };
+	shape.clref = TypeID{ type_name_add_const_lvalue_reference_hash(raw) };
+	shape.rref = TypeID{ type_name_add_rvalue_reference_hash(raw) };
+	shape.crref = TypeID{ type_name_add_const_rvalue_reference_hash(raw) };
+
+	id2shape.Insert(ID, shape);
 }
 
 //
@@ -173,7 +248,9 @@ TypeID TypeIDRegistry::Register(std::string_view name) {
 /////////////////////
 
 TypeID TypeIDRegistry::RegisterAddLValueReference(TypeID ID) {
-	std::string_view name = Nameof(ID);
+	std::unique_lock lock{ mutex };
+
+	std::string_view name = Nameof_Unlocked(ID);
 	if (name.empty())
 		return {};
 
@@ -182,11 +259,16 @@ TypeID TypeIDRegistry::RegisterAddLValueReference(TypeID ID) {
 	if (rst_name.data() == name.data())
 		return ID;
 
-	return RegisterUnmanaged(rst_name);
+	TypeID rstID{ rst_name };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(rstID, rst_name);
+	RegisterShape(rstID, rst_name);
+	return rstID;
 }
 
 TypeID TypeIDRegistry::RegisterAddConstLValueReference(TypeID ID) {
-	std::string_view name = Nameof(ID);
+	std::unique_lock lock{ mutex };
+
+	std::string_view name = Nameof_Unlocked(ID);
 	if (name.empty())
 		return {};
 
@@ -195,11 +277,16 @@ TypeID TypeIDRegistry::RegisterAddConstLValueReference(TypeID ID) {
 	if (rst_name.data() == name.data())
 		return ID;
 
-	return RegisterUnmanaged(rst_name);
+	TypeID rstID{ rst_name };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(rstID, rst_name);
+	RegisterShape(rstID, rst_name);
+	return rstID;
 }
 
 TypeID TypeIDRegistry::RegisterAddRValueReference(TypeID ID) {
-	std::string_view name = Nameof(ID);
+	std::unique_lock lock{ mutex };
+
+	std::string_view name = Nameof_Unlocked(ID);
 	if (name.empty())
 		return {};
 
@@ -208,11 +295,16 @@ TypeID TypeIDRegistry::RegisterAddRValueReference(TypeID ID) {
 	if (rst_name.data() == name.data())
 		return ID;
 
-	return RegisterUnmanaged(rst_name);
+	TypeID rstID{ rst_name };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(rstID, rst_name);
+	RegisterShape(rstID, rst_name);
+	return rstID;
 }
 
 TypeID TypeIDRegistry::RegisterAddConstRValueReference(TypeID ID) {
-	std::string_view name = Nameof(ID);
+	std::unique_lock lock{ mutex };
+
+	std::string_view name = Nameof_Unlocked(ID);
 	if (name.empty())
 		return {};
 
@@ -221,5 +313,8 @@ TypeID TypeIDRegistry::RegisterAddConstRValueReference(TypeID ID) {
 	if (rst_name.data() == name.data())
 		return ID;
 
-	return RegisterUnmanaged(rst_name);
+	TypeID rstID{ rst_name };
+	IDRegistry<TypeID>::RegisterUnmanaged_Unlocked(rstID, rst_name);
+	RegisterShape(rstID, rst_name);
+	return rstID;
 }
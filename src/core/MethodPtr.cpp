@@ -2,74 +2,91 @@
 
 using namespace Ubpa::UDRefl;
 
+ParamList::ParamList(std::span<const TypeID> ids) : count{ ids.size() } {
+	TypeID* dst = IsInline() ? inline_ids.data() : (heap_ids = new TypeID[count]);
+	std::copy(ids.begin(), ids.end(), dst);
+}
+
+ParamList::ParamList(ParamList&& rhs) noexcept : count{ rhs.count } {
+	if (rhs.IsInline())
+		inline_ids = rhs.inline_ids;
+	else {
+		heap_ids = rhs.heap_ids;
+		rhs.count = 0;
+	}
+}
+
+ParamList& ParamList::operator=(const ParamList& rhs) {
+	if (this != &rhs)
+		*this = ParamList{ rhs };
+	return *this;
+}
+
+ParamList& ParamList::operator=(ParamList&& rhs) noexcept {
+	if (this != &rhs) {
+		if (!IsInline())
+			delete[] heap_ids;
+		count = rhs.count;
+		if (rhs.IsInline())
+			inline_ids = rhs.inline_ids;
+		else {
+			heap_ids = rhs.heap_ids;
+			rhs.count = 0;
+		}
+	}
+	return *this;
+}
+
 Destructor MethodPtr::Invoke(void* obj, void* result_buffer, ArgsBuffer args_buffer) const {
-	return std::visit([=, this](const auto& f) {
-		using Func = std::decay_t<decltype(f)>;
-		if constexpr (std::is_same_v<Func, MemberVariableFunction*>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, MemberConstFunction*>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, StaticFunction*>)
-			return f(     result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<MemberVariableFunction>>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<MemberConstFunction>>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<StaticFunction>>)
-			return f(     result_buffer, { args_buffer,paramList });
-		else
-			static_assert(always_false<Func>);
-	}, func);
+	ArgsView args{ args_buffer, paramList };
+	switch (kind)
+	{
+	case Kind::MemberVariable:
+		return memberVariableFunction(obj, result_buffer, args);
+	case Kind::MemberConst:
+		return memberConstFunction(obj, result_buffer, args);
+	case Kind::Static:
+		return staticFunction(result_buffer, args);
+	case Kind::MemberVariableCallable:
+		return memberVariableInvoker(GetCallable(), obj, result_buffer, args);
+	case Kind::MemberConstCallable:
+		return memberConstInvoker(GetCallable(), obj, result_buffer, args);
+	case Kind::StaticCallable:
+		return staticInvoker(GetCallable(), result_buffer, args);
+	default:
+		assert(false);
+		return {};
+	}
 };
 
 Destructor MethodPtr::Invoke(const void* obj, void* result_buffer, ArgsBuffer args_buffer) const {
-	return std::visit([=, this](const auto& f)->Destructor {
-		using Func = std::decay_t<decltype(f)>;
-		if constexpr (std::is_same_v<Func, MemberVariableFunction*>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, MemberConstFunction*>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, StaticFunction*>)
-			return f(     result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<MemberVariableFunction>>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, std::function<MemberConstFunction>>)
-			return f(obj, result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<StaticFunction>>)
-			return f(     result_buffer, { args_buffer,paramList });
-		else
-			static_assert(always_false<Func>);
-	}, func);
+	ArgsView args{ args_buffer, paramList };
+	switch (kind)
+	{
+	case Kind::MemberConst:
+		return memberConstFunction(obj, result_buffer, args);
+	case Kind::Static:
+		return staticFunction(result_buffer, args);
+	case Kind::MemberConstCallable:
+		return memberConstInvoker(GetCallable(), obj, result_buffer, args);
+	case Kind::StaticCallable:
+		return staticInvoker(GetCallable(), result_buffer, args);
+	default: // member variable
+		assert(false);
+		return {};
+	}
 };
 
 Destructor MethodPtr::Invoke(void* result_buffer, ArgsBuffer args_buffer) const {
-	return std::visit([=, this](const auto& f)->Destructor {
-		using Func = std::decay_t<decltype(f)>;
-		if constexpr (std::is_same_v<Func, MemberVariableFunction*>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, MemberConstFunction*>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, StaticFunction*>)
-			return f(result_buffer, { args_buffer,paramList });
-		else if constexpr (std::is_same_v<Func, std::function<MemberVariableFunction>>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, std::function<MemberConstFunction>>) {
-			assert(false);
-			return {};
-		}
-		else if constexpr (std::is_same_v<Func, std::function<StaticFunction>>)
-			return f(result_buffer, { args_buffer,paramList });
-		else
-			static_assert(always_false<Func>);
-	}, func);
+	ArgsView args{ args_buffer, paramList };
+	switch (kind)
+	{
+	case Kind::Static:
+		return staticFunction(result_buffer, args);
+	case Kind::StaticCallable:
+		return staticInvoker(GetCallable(), result_buffer, args);
+	default: // member
+		assert(false);
+		return {};
+	}
 };
@@ -0,0 +1,46 @@
+#include <UDRefl/MethodResolutionCache.h>
+
+#include <algorithm>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+std::size_t MethodResolutionCache::KeyHash::operator()(const KeyView& key) const noexcept {
+	auto combine = [](std::size_t seed, std::size_t value) noexcept {
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	};
+
+	std::size_t rst = key.typeID.GetValue();
+	rst = combine(rst, key.methodID.GetValue());
+	rst = combine(rst, static_cast<std::size_t>(key.mode));
+	for (const auto& ID : key.argTypeIDs)
+		rst = combine(rst, ID.GetValue());
+	return rst;
+}
+
+bool MethodResolutionCache::KeyEqual::Equal(const KeyView& lhs, const KeyView& rhs) noexcept {
+	return lhs.typeID == rhs.typeID
+		&& lhs.methodID == rhs.methodID
+		&& lhs.mode == rhs.mode
+		&& std::equal(lhs.argTypeIDs.begin(), lhs.argTypeIDs.end(), rhs.argTypeIDs.begin(), rhs.argTypeIDs.end());
+}
+
+const MethodResolution* MethodResolutionCache::Find(
+	TypeID typeID,
+	StrID methodID,
+	MethodSearchMode mode,
+	std::span<const TypeID> argTypeIDs) const
+{
+	return resolutions.Find(KeyView{ typeID, methodID, mode, argTypeIDs });
+}
+
+const MethodResolution& MethodResolutionCache::Insert(
+	TypeID typeID,
+	StrID methodID,
+	MethodSearchMode mode,
+	std::span<const TypeID> argTypeIDs,
+	MethodResolution resolution)
+{
+	Key key{ typeID, methodID, mode, { argTypeIDs.begin(), argTypeIDs.end() } };
+	return resolutions.Insert(std::move(key), std::move(resolution));
+}
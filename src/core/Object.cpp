@@ -10,6 +10,13 @@ using namespace Ubpa::UDRefl;
 //////////////////
 
 TypeInfo* ObjectPtrBase::GetType() const {
+	if (ReflMngr::Instance().IsFrozen()) {
+		ReflMngr::ReadGuard guard;
+		const FrozenTypeInfo* ftypeinfo = ReflMngr::Instance().GetFrozenTypeInfo(ID);
+		// the nodes of ReflMngr::typeinfos are mutable and outlive the published tables
+		return ftypeinfo ? const_cast<TypeInfo*>(ftypeinfo->typeinfo) : nullptr;
+	}
+
 	auto target = ReflMngr::Instance().typeinfos.find(ID);
 	if (target == ReflMngr::Instance().typeinfos.end())
 		return nullptr;
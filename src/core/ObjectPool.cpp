@@ -0,0 +1,198 @@
+#include <UDRefl/ObjectPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	static std::atomic<std::size_t> object_pool_count{ 0 };
+}
+
+//
+// ThreadCache
+////////////////
+
+// a thread's free lists, indexed by ObjectPool::index
+class ObjectPool::ThreadCache {
+public:
+	struct Entry {
+		ObjectPool* pool{ nullptr };
+		FreeList list;
+	};
+
+	ThreadCache() noexcept { state = State::Alive; }
+
+	~ThreadCache() {
+		state = State::Destroyed;
+		// give the blocks back, so the other threads can use them
+		for (Entry& entry : entries) {
+			if (!entry.pool || entry.list.count == 0)
+				continue;
+			std::lock_guard lock{ entry.pool->central_mutex };
+			Transfer(entry.list, entry.pool->central, entry.list.count);
+		}
+	}
+
+	Entry& Get(ObjectPool* pool) {
+		if (pool->index >= entries.size())
+			entries.resize(pool->index + 1);
+		Entry& entry = entries[pool->index];
+		entry.pool = pool;
+		return entry;
+	}
+
+	// nullptr if the thread never used the pool
+	Entry* Find(const ObjectPool* pool) noexcept {
+		return pool->index < entries.size() && entries[pool->index].pool == pool ? &entries[pool->index] : nullptr;
+	}
+
+	// nullptr once the thread's cache is destroyed (thread exit, static destruction)
+	static ThreadCache* Instance() {
+		if (state == State::Destroyed)
+			return nullptr;
+		static thread_local ThreadCache instance;
+		return &instance;
+	}
+
+private:
+	enum class State : std::uint8_t { None, Alive, Destroyed };
+	// trivially destructible, so it is readable after the cache is destroyed
+	static thread_local State state;
+
+	std::vector<Entry> entries;
+};
+
+thread_local ObjectPool::ThreadCache::State ObjectPool::ThreadCache::state = ObjectPool::ThreadCache::State::None;
+
+//
+// ObjectPool
+///////////////
+
+ObjectPool::ObjectPool(
+	std::size_t block_size,
+	std::size_t block_alignment,
+	std::size_t blocks_per_slab,
+	std::pmr::memory_resource* upstream)
+	:
+	block_size{ SizeClass(block_size, block_alignment) },
+	block_alignment{ std::max(block_alignment, alignof(FreeBlock)) },
+	blocks_per_slab{ std::max<std::size_t>(blocks_per_slab, 1) },
+	batch_size{ std::max<std::size_t>(blocks_per_slab / 2, 1) },
+	index{ details::object_pool_count.fetch_add(1, std::memory_order_relaxed) },
+	upstream{ upstream }
+{
+	assert(std::has_single_bit(block_alignment));
+}
+
+ObjectPool::~ObjectPool() {
+	// the calling thread's list refers to the slabs
+	if (ThreadCache* cache = ThreadCache::Instance()) {
+		if (auto* entry = cache->Find(this))
+			*entry = {};
+	}
+
+	for (void* slab : slabs)
+		upstream->deallocate(slab, block_size * blocks_per_slab, block_alignment);
+}
+
+std::size_t ObjectPool::SizeClass(std::size_t size, std::size_t alignment) noexcept {
+	size = std::max(size, sizeof(FreeBlock));
+	// multiples of 16 up to 256, then powers of 2
+	std::size_t block_size = size <= 256 ? (size + 15) / 16 * 16 : std::bit_ceil(size);
+	// a multiple of the alignment keeps every block of a slab aligned
+	return (block_size + alignment - 1) / alignment * alignment;
+}
+
+std::size_t ObjectPool::NumSlabs() const {
+	std::lock_guard lock{ central_mutex };
+	return slabs.size();
+}
+
+ObjectPool::FreeList* ObjectPool::LocalList() {
+	ThreadCache* cache = ThreadCache::Instance();
+	return cache ? &cache->Get(this).list : nullptr;
+}
+
+void* ObjectPool::Pop(FreeList& list) noexcept {
+	assert(list.head);
+	FreeBlock* block = list.head;
+	list.head = block->next;
+	--list.count;
+	return block;
+}
+
+void ObjectPool::Push(FreeList& list, void* block) noexcept {
+	auto* freeblock = static_cast<FreeBlock*>(block);
+	freeblock->next = list.head;
+	list.head = freeblock;
+	++list.count;
+}
+
+void ObjectPool::Transfer(FreeList& from, FreeList& to, std::size_t count) noexcept {
+	for (std::size_t i = 0; i < count && from.head; i++)
+		Push(to, Pop(from));
+}
+
+void ObjectPool::AllocateSlab() {
+	auto* slab = static_cast<std::byte*>(upstream->allocate(block_size * blocks_per_slab, block_alignment));
+	slabs.push_back(slab);
+
+	// in address order, so the first allocations are contiguous
+	for (std::size_t i = blocks_per_slab; i > 0; i--) {
+		auto* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+		block->next = central.head;
+		central.head = block;
+	}
+	central.count += blocks_per_slab;
+}
+
+void* ObjectPool::Allocate() {
+	FreeList* local = LocalList();
+
+	if (!local || !local->head) {
+		std::lock_guard lock{ central_mutex };
+		if (!central.head)
+			AllocateSlab();
+		if (!local)
+			return Pop(central);
+		Transfer(central, *local, batch_size);
+	}
+
+	return Pop(*local);
+}
+
+void ObjectPool::Deallocate(void* block) {
+	if (!block)
+		return;
+
+	FreeList* local = LocalList();
+
+	if (!local) {
+		std::lock_guard lock{ central_mutex };
+		Push(central, block);
+		return;
+	}
+
+	Push(*local, block);
+
+	// a thread which only frees (e.g. a consumer) hands the blocks back
+	if (local->count > 2 * batch_size) {
+		std::lock_guard lock{ central_mutex };
+		Transfer(*local, central, batch_size);
+	}
+}
+
+void* ObjectPool::do_allocate([[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment) {
+	assert(bytes <= block_size && alignment <= block_alignment);
+	return Allocate();
+}
+
+void ObjectPool::do_deallocate(void* p, [[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment) {
+	assert(bytes <= block_size && alignment <= block_alignment);
+	Deallocate(p);
+}
@@ -1,5 +1,8 @@
 #include <UDRefl/ReflMngr.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <set>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -18,8 +21,11 @@ namespace Ubpa::UDRefl::details {
 				result_rsrc->deallocate(ptr, size, alignment);
 			};
 		}
-		else // !dtor
-			return [](void* ptr) { assert(ptr); };
+		else { // !dtor, e.g. trivially destructible
+			return [result_rsrc, size, alignment](void* ptr) {
+				result_rsrc->deallocate(ptr, size, alignment);
+			};
+		}
 	}
 
 	// parameter <- argument
@@ -41,29 +47,20 @@ namespace Ubpa::UDRefl::details {
 			if (params[i] == argTypeIDs[i])
 				continue;
 
-			auto lhs = Mngr->tregistry.Nameof(params[i]);
-
-#ifndef NDEBUG
-			// because rhs(arg)'s ID maybe have no name in the registry
-			// so we use type_name_add_*_hash(...) to avoid it
-			auto rhs = Mngr->tregistry.Nameof(argTypeIDs[i]);
-#endif // !NDEBUG
-
-			const std::size_t rhs_hash = argTypeIDs[i].GetValue();
+			// rhs(arg)'s ID maybe have no shape in the registry, so we only compare with lhs's shape
+			const auto* lhs = Mngr->tregistry.GetShape(params[i]);
+			if (!lhs)
+				return false;
 
-			assert(!type_name_is_const(lhs) && !type_name_is_volatile(lhs));
+			const TypeID rhs = argTypeIDs[i];
 
-			if (type_name_is_rvalue_reference(lhs)) { // &&{T} | &&{const{T}}
-				auto unref_lhs = type_name_remove_reference(lhs); // T | const{T}
-				assert(!type_name_is_volatile(unref_lhs));
-				if (TypeID{ unref_lhs }.GetValue() == rhs_hash)
+			if (lhs->IsRValueReference()) { // &&{T} | &&{const{T}}
+				if (lhs->referee == rhs)
 					continue; // &&{T} <- T
 			}
-			else {
-				if (!type_name_is_lvalue_reference(lhs)) { // T
-					if (type_name_add_rvalue_reference_hash(lhs) == rhs_hash)
-						continue; // T <- &&{T}
-				}
+			else if (!lhs->IsLValueReference()) { // T
+				if (lhs->rref == rhs)
+					continue; // T <- &&{T}
 			}
 
 			return false;
@@ -91,53 +88,37 @@ namespace Ubpa::UDRefl::details {
 			if (params[i] == argTypeIDs[i])
 				continue;
 
-			auto lhs = Mngr->tregistry.Nameof(params[i]);
-#ifndef NDEBUG
-			// because rhs(arg)'s ID maybe have no name in the registry
-			// so we use type_name_add_*_hash(...) to avoid it
-			auto rhs = Mngr->tregistry.Nameof(argTypeIDs[i]);
-#endif // !NDEBUG
-			const std::size_t rhs_hash = argTypeIDs[i].GetValue();
-
-			assert(!type_name_is_const(lhs) && !type_name_is_volatile(lhs));
-			if (type_name_is_lvalue_reference(lhs)) { // &{T} | &{const{T}}
-				auto unref_lhs = type_name_remove_reference(lhs); // T | const{T}
-				if (type_name_is_const(unref_lhs)) { // &{const{T}}
-					if (type_name_add_rvalue_reference_hash(unref_lhs) == rhs_hash)
-						continue; // &{const{T}} <- &&{const{T}}
+			// rhs(arg)'s ID maybe have no shape in the registry, so we only compare with lhs's shape
+			const auto* lhs = Mngr->tregistry.GetShape(params[i]);
+			if (!lhs)
+				return false;
+
+			const TypeID rhs = argTypeIDs[i];
 
-					auto raw_lhs = type_name_remove_const(unref_lhs); // T
-					TypeID raw_lhs_ID{ raw_lhs };
+			if (lhs->IsLValueReference()) { // &{T} | &{const{T}}
+				if (lhs->is_const) { // &{const{T}}
+					if (lhs->crref == rhs)
+						continue; // &{const{T}} <- &&{const{T}}
 
-					if (raw_lhs_ID.GetValue() == rhs_hash
-						|| type_name_add_lvalue_reference_hash(raw_lhs) == rhs_hash
-						|| type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash)
+					if (lhs->raw == rhs || lhs->lref == rhs || lhs->rref == rhs)
 						continue; // &{const{T}} <- T | &{T} | &&{T}
 				}
 			}
-			else if (type_name_is_rvalue_reference(lhs)) { // &&{T} | &&{const{T}}
-				auto unref_lhs = type_name_remove_reference(lhs); // T | const{T}
-				assert(!type_name_is_volatile(unref_lhs));
-
-				if (type_name_is_const(unref_lhs)) { // &&{const{T}}
-					auto raw_lhs = type_name_remove_const(unref_lhs); // T
-					TypeID raw_lhs_ID{ raw_lhs };
-
-					if (raw_lhs_ID.GetValue() == rhs_hash)
+			else if (lhs->IsRValueReference()) { // &&{T} | &&{const{T}}
+				if (lhs->is_const) { // &&{const{T}}
+					if (lhs->raw == rhs)
 						continue; // &&{const{T}} <- T
 
-					if (type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash) // &&{const{T}}
+					if (lhs->rref == rhs)
 						continue; // &&{const{T}} <- &&{T}
 				}
 				else {
-					TypeID unref_lhs_ID{ unref_lhs };
-
-					if (unref_lhs_ID.GetValue() == rhs_hash)
+					if (lhs->raw == rhs)
 						continue; // &&{T} <- T
 				}
 			}
 			else { // T
-				if (type_name_add_rvalue_reference_hash(lhs) == rhs_hash)
+				if (lhs->rref == rhs)
 					continue; // T <- &&{T}
 			}
 
@@ -175,627 +156,871 @@ namespace Ubpa::UDRefl::details {
 		AddConvertCtor<T, double>(mngr);
 	}
 
-	class ConstructedArgumentsGuard {
-		struct CopyInfo {
-			size_t idx;
-			bool isPtr;
-		};
+	// applies an ArgumentConversionPlan, the scratch is on the stack if it fits
+	class ArgumentConversionGuard {
 	public:
-		ConstructedArgumentsGuard(
+		ArgumentConversionGuard(
 			std::pmr::memory_resource* rsrc,
-			std::span<const TypeID> paramTypeIDs,
-			std::span<const TypeID> argTypeIDs,
+			const ArgumentConversionPlan& plan,
 			ArgsBuffer orig_args_buffer)
 			:
 			rsrc{ rsrc },
-			paramTypeIDs{ paramTypeIDs },
-			infos{ rsrc }
+			plan{ plan }
 		{
-			assert(Mngr->IsCompatible(paramTypeIDs, argTypeIDs));
-			void** constructed_args_buffer = nullptr;
-			for (std::size_t i = 0; i < argTypeIDs.size(); i++) {
-				if (paramTypeIDs[i] == argTypeIDs[i])
-					continue;
-
-				auto lhs = Mngr->tregistry.Nameof(paramTypeIDs[i]);
-#ifndef NDEBUG
-				auto rhs = Mngr->tregistry.Nameof(argTypeIDs[i]);
-#endif // NDEBUG
-				const std::size_t rhs_hash = argTypeIDs[i].GetValue();
-
-				if (type_name_is_lvalue_reference(lhs)) { // &{T} or &{const{T}}
-					auto unref_lhs = type_name_remove_reference(lhs); // T or const{T}
-					if (type_name_is_const(unref_lhs)) { // &{const{T}}
-						auto raw_lhs = type_name_remove_const(unref_lhs); // T
-						std::size_t raw_lhs_hash = string_hash(raw_lhs);
-						if (raw_lhs_hash == rhs_hash
-							|| type_name_add_lvalue_reference_hash(raw_lhs) == rhs_hash
-							|| type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash
-							|| type_name_add_const_rvalue_reference_hash(raw_lhs) == rhs_hash)
-							continue;
-					}
-					else // &{T}
-						continue;
-				}
-				else if (type_name_is_rvalue_reference(lhs)) { // &&{T} or &&{const{T}}
-					auto unref_lhs = type_name_remove_reference(lhs); // T or const{T}
-					if (type_name_is_const(unref_lhs)) { // &&{const{T}}
-						auto raw_lhs = type_name_remove_const(unref_lhs); // T
-						if (string_hash(raw_lhs) == rhs_hash || type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash)
-							continue;
-					}
-					else { // &&{T}
-						if (string_hash(unref_lhs) == rhs_hash)
-							continue;
-					}
-				}
-				else { // T
-					if (type_name_add_rvalue_reference_hash(lhs) == rhs_hash)
-						continue;
-				}
-				
-				if (!constructed_args_buffer) {
-					constructed_args_buffer = static_cast<void**>(rsrc->allocate(argTypeIDs.size() * sizeof(void*), alignof(ArgsBuffer)));
-					assert(constructed_args_buffer);
-					for (size_t j = 0; j < argTypeIDs.size(); j++)
-						constructed_args_buffer[j] = orig_args_buffer[j];
-				}
+			if (plan.IsPassThrough()) {
+				args_buffer = orig_args_buffer;
+				return;
+			}
 
-				std::string_view name = Mngr->tregistry.Nameof(paramTypeIDs[i]);
-				if (type_name_is_pointer(name)) {
-					void** ptr_buffer = static_cast<void**>(rsrc->allocate(sizeof(void*), alignof(void*)));
-					*ptr_buffer = *reinterpret_cast<void**>(orig_args_buffer[i]);
-					constructed_args_buffer[i] = ptr_buffer;
-					infos.push_back({ i, true});
-				}
-				else {
-					std::array<TypeID, 1> tmp_argTypeIDs = { TypeID{type_name_add_const_lvalue_reference_hash(lhs)} };
-					std::array<void*, 1> tmp_args_buffer = { orig_args_buffer[i] };
-					ObjectPtr constructedArg = Mngr->MNew(paramTypeIDs[i], rsrc, std::span<const TypeID>{tmp_argTypeIDs}, static_cast<ArgsBuffer>(tmp_args_buffer.data()));
-					constructed_args_buffer[i] = constructedArg.GetPtr();
-					infos.push_back({ i, false });
-				}
+			if (plan.FitsInline()) {
+				scratch = inline_scratch;
+				args_buffer = plan.Apply(scratch, orig_args_buffer);
+				return;
 			}
 
-			if (constructed_args_buffer)
-				args_buffer = constructed_args_buffer;
-			else
-				args_buffer = orig_args_buffer;
+			scratch = rsrc->allocate(plan.GetScratchSize(), plan.GetScratchAlignment());
+			assert(scratch);
+			try {
+				args_buffer = plan.Apply(scratch, orig_args_buffer);
+			}
+			catch (...) {
+				// an arena only takes LIFO deallocations back
+				rsrc->deallocate(scratch, plan.GetScratchSize(), plan.GetScratchAlignment());
+				throw;
+			}
 		}
 
-		~ConstructedArgumentsGuard() {
-			if (infos.empty())
+		~ArgumentConversionGuard() {
+			if (!scratch)
 				return;
 
-			for (const auto& [idx, isPtr] : infos) {
-				if (isPtr)
-					rsrc->deallocate(args_buffer[idx], sizeof(void*), alignof(void*));
-				else {
-					bool success = Mngr->MDelete({ paramTypeIDs[idx], args_buffer[idx] }, rsrc);
-					assert(success);
-				}
-			}
+			plan.Release(scratch);
 
-			rsrc->deallocate(const_cast<void**>(args_buffer), paramTypeIDs.size() * sizeof(void*), alignof(ArgsBuffer));
+			if (scratch != inline_scratch)
+				rsrc->deallocate(scratch, plan.GetScratchSize(), plan.GetScratchAlignment());
 		}
 
+		ArgumentConversionGuard(const ArgumentConversionGuard&) = delete;
+		ArgumentConversionGuard& operator=(const ArgumentConversionGuard&) = delete;
+
 		ArgsBuffer GetArgsBuffer() const noexcept { return args_buffer; }
 	private:
 		std::pmr::memory_resource* rsrc;
-		std::span<const TypeID> paramTypeIDs;
+		const ArgumentConversionPlan& plan;
 		ArgsBuffer args_buffer{ nullptr };
-		std::pmr::vector<CopyInfo> infos;
+		void* scratch{ nullptr };
+		alignas(std::max_align_t) std::uint8_t inline_scratch[ArgumentConversionPlan::InlineScratchSize];
 	};
 
-	static InvocableResult IsStaticInvocable(
-		bool is_priority,
-		TypeID typeID,
-		StrID methodID,
-		std::span<const TypeID> argTypeIDs)
-	{
-		auto typetarget = Mngr->typeinfos.find(typeID);
+	// typeinfo lookup
+	// - frozen: one probe into the flat tables, pinned while the view lives
+	// - else: walk the node-based maps of ReflMngr::typeinfos
+	class TypeInfoView {
+	public:
+		explicit TypeInfoView(TypeID typeID) {
+			if (Mngr->IsFrozen()) {
+				ftypeinfo = Mngr->GetFrozenTypeInfo(typeID);
+				if (ftypeinfo)
+					typeinfo = ftypeinfo->typeinfo;
+			}
+			else {
+				auto target = Mngr->typeinfos.find(typeID);
+				if (target != Mngr->typeinfos.end())
+					typeinfo = &target->second;
+			}
+		}
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+		explicit operator bool() const noexcept { return typeinfo != nullptr; }
+		const TypeInfo& operator*() const noexcept { assert(typeinfo); return *typeinfo; }
+		const TypeInfo* operator->() const noexcept { assert(typeinfo); return typeinfo; }
 
-		const auto& typeinfo = typetarget->second;
+		// self field (bases' excluded)
+		const FieldInfo* FindField(StrID fieldID) const noexcept {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				auto target = ftypeinfo->fieldinfos.Find(fieldID);
+				return target ? *target : nullptr;
+			}
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (mtarget->second.methodptr.IsStatic()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-				return { true, mtarget->second.methodptr.GetResultDesc() };
+			auto target = typeinfo->fieldinfos.find(fieldID);
+			return target != typeinfo->fieldinfos.end() ? &target->second : nullptr;
 		}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = IsStaticInvocable(is_priority, baseID, methodID, argTypeIDs);
-			if (rst)
-				return rst;
+		// the nodes of ReflMngr::typeinfos are mutable, for FieldPtr::RWVar
+		FieldInfo* FindVarField(StrID fieldID) const noexcept {
+			return const_cast<FieldInfo*>(FindField(fieldID));
 		}
 
-		return {};
-	}
+		// first self method (bases' excluded) named methodID with pred(methodptr)
+		template<typename Pred>
+		const MethodInfo* FindMethod(StrID methodID, Pred&& pred) const {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				if (auto overloads = ftypeinfo->methodinfos.Find(methodID)) {
+					for (const MethodInfo* methodinfo : *overloads) {
+						if (pred(methodinfo->methodptr))
+							return methodinfo;
+					}
+				}
+				return nullptr;
+			}
 
-	static InvocableResult IsConstInvocable(
-		bool is_priority,
-		TypeID typeID,
-		StrID methodID,
-		std::span<const TypeID> argTypeIDs)
-	{
-		auto typetarget = Mngr->typeinfos.find(typeID);
+			auto [begin_iter, end_iter] = typeinfo->methodinfos.equal_range(methodID);
+			for (auto iter = begin_iter; iter != end_iter; ++iter) {
+				if (pred(iter->second.methodptr))
+					return &iter->second;
+			}
+			return nullptr;
+		}
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+		// self methods (bases' excluded) named methodID, stop when func(methodinfo) returns true
+		template<typename Func>
+		bool AnyMethod(StrID methodID, Func&& func) const {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				if (auto overloads = ftypeinfo->methodinfos.Find(methodID)) {
+					for (const MethodInfo* methodinfo : *overloads) {
+						if (func(*methodinfo))
+							return true;
+					}
+				}
+				return false;
+			}
+
+			auto [begin_iter, end_iter] = typeinfo->methodinfos.equal_range(methodID);
+			for (auto iter = begin_iter; iter != end_iter; ++iter) {
+				if (func(iter->second))
+					return true;
+			}
+			return false;
+		}
+
+		// self fields (bases' excluded) in the order of TypeInfo::fieldinfos
+		// - stop when func(fieldID, fieldinfo) returns true
+		// - the nodes of ReflMngr::typeinfos are mutable, for FieldRef
+		template<typename Func>
+		bool AnyField(Func&& func) const {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				for (const auto& [fieldID, fieldinfo] : ftypeinfo->ordered_fieldinfos) {
+					if (func(fieldID, const_cast<FieldInfo&>(*fieldinfo)))
+						return true;
+				}
+				return false;
+			}
+
+			for (auto& [fieldID, fieldinfo] : const_cast<TypeInfo*>(typeinfo)->fieldinfos) {
+				if (func(fieldID, fieldinfo))
+					return true;
+			}
+			return false;
+		}
 
-		const auto& typeinfo = typetarget->second;
+		// self methods (bases' excluded) in the order of TypeInfo::methodinfos
+		// - stop when func(methodID, methodinfo) returns true
+		// - the nodes of ReflMngr::typeinfos are mutable, for MethodRef
+		template<typename Func>
+		bool AnyMethod(Func&& func) const {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				for (const auto& [methodID, methodinfo] : ftypeinfo->ordered_methodinfos) {
+					if (func(methodID, const_cast<MethodInfo&>(*methodinfo)))
+						return true;
+				}
+				return false;
+			}
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (!mtarget->second.methodptr.IsMemberVariable()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-				return { true, mtarget->second.methodptr.GetResultDesc() };
+			for (auto& [methodID, methodinfo] : const_cast<TypeInfo*>(typeinfo)->methodinfos) {
+				if (func(methodID, methodinfo))
+					return true;
+			}
+			return false;
 		}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = IsConstInvocable(is_priority, baseID, methodID, argTypeIDs);
-			if (rst)
-				return rst;
+		// the nodes of ReflMngr::typeinfos are mutable, for TypeRef
+		TypeRef Ref(TypeID typeID) const noexcept {
+			assert(typeinfo);
+			return { typeID, const_cast<TypeInfo&>(*typeinfo) };
 		}
 
-		return {};
-	}
+		// stop when func(baseID, baseinfo) returns true
+		template<typename Func>
+		bool AnyBase(Func&& func) const {
+			assert(typeinfo);
+			if (ftypeinfo) {
+				for (const auto& [baseID, baseinfo] : ftypeinfo->baseinfos) {
+					if (func(baseID, *baseinfo))
+						return true;
+				}
+				return false;
+			}
 
-	static InvocableResult IsInvocable(
-		bool is_priority,
-		TypeID typeID,
-		StrID methodID,
-		std::span<const TypeID> argTypeIDs)
-	{
-		auto typetarget = Mngr->typeinfos.find(typeID);
+			for (const auto& [baseID, baseinfo] : typeinfo->baseinfos) {
+				if (func(baseID, baseinfo))
+					return true;
+			}
+			return false;
+		}
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+		ObjectPool* GetPool() const noexcept {
+			assert(typeinfo);
+			return ftypeinfo ? ftypeinfo->pool : typeinfo->pool;
+		}
 
-		const auto& typeinfo = typetarget->second;
+		ObjectPool* GetSharedPool() const noexcept {
+			assert(typeinfo);
+			return ftypeinfo ? ftypeinfo->shared_pool : typeinfo->shared_pool;
+		}
+
+	private:
+		ReflMngr::ReadGuard guard;
+		const TypeInfo* typeinfo{ nullptr };
+		const FrozenTypeInfo* ftypeinfo{ nullptr };
+	};
 
-		auto common_mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
+	// params must be compatible with argTypeIDs (ReflMngr::IsCompatible)
+	// - the analysis of ReflMngr::IsCompatible, done once
+	// - a temporary is constructed from the argument itself (T{arg}) by a ctor binding it directly
+	static ArgumentConversionPlan CompileArgumentConversionPlan(std::span<const TypeID> params, std::span<const TypeID> argTypeIDs) {
+		assert(Mngr->IsCompatible(params, argTypeIDs));
 
-		{ // 1. object variable and static
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (!iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					return { true, iter->second.methodptr.GetResultDesc() };
-				}
+		ArgumentConversionPlan plan{ argTypeIDs.size() };
+		for (std::size_t i = 0; i < argTypeIDs.size(); i++) {
+			if (params[i] == argTypeIDs[i])
+				continue;
+
+			const auto* lhs = Mngr->tregistry.GetShape(params[i]);
+			assert(lhs);
+			const TypeID rhs = argTypeIDs[i];
+
+			if (lhs->IsLValueReference()) { // &{T} | &{const{T}}
+				assert(lhs->is_const); // &{T} only binds &{T}
+				if (lhs->raw == rhs || lhs->lref == rhs || lhs->rref == rhs || lhs->crref == rhs)
+					continue; // &{const{T}} <- T | &{T} | &&{T} | &&{const{T}}
 			}
-		}
+			else if (lhs->IsRValueReference()) { // &&{T} | &&{const{T}}
+				if (lhs->raw == rhs)
+					continue; // &&{T} | &&{const{T}} <- T
 
-		{ // 2. object const
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					return { true, iter->second.methodptr.GetResultDesc() };
+				if (lhs->is_const && lhs->rref == rhs)
+					continue; // &&{const{T}} <- &&{T}
+			}
+			else { // T
+				if (lhs->rref == rhs)
+					continue; // T <- &&{T}
+
+				if (lhs->is_pointer && (lhs->lref == rhs || lhs->clref == rhs || lhs->crref == rhs)) {
+					plan.AddCopyPointer(i); // T <- T{arg} [copy]
+					continue;
 				}
 			}
-		}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = IsInvocable(is_priority, baseID, methodID, argTypeIDs);
-			if (rst)
-				return rst;
+			// T{arg}
+			TypeInfoView typeinfo{ lhs->raw };
+			assert(typeinfo);
+			if (typeinfo->traits.is_trivially_copy_constructible && !lhs->IsReference()
+				&& (lhs->lref == rhs || lhs->clref == rhs || lhs->crref == rhs))
+			{
+				plan.AddCopy(i, typeinfo->size, typeinfo->alignment); // T <- T{arg} [memcpy]
+				continue;
+			}
+			std::span<const TypeID> ctor_argTypeIDs{ &argTypeIDs[i], 1 };
+			const MethodInfo* ctor = typeinfo.FindMethod(StrIDRegistry::MetaID::ctor, [&](const MethodPtr& methodptr) {
+				return methodptr.IsMemberVariable() && IsNonArgCopyConstructCompatible(methodptr.GetParamList(), ctor_argTypeIDs);
+			});
+			assert(ctor);
+			const MethodInfo* dtor = typeinfo->traits.is_trivially_destructible ? nullptr
+				: typeinfo.FindMethod(StrIDRegistry::MetaID::dtor, [](const MethodPtr& methodptr) {
+					return methodptr.IsMemberConst() && methodptr.GetParamList().empty();
+				});
+			plan.AddConstruct(i, typeinfo->size, typeinfo->alignment, ctor->methodptr, dtor ? &dtor->methodptr : nullptr);
 		}
 
-		return {};
+		return plan;
 	}
 
-	static InvokeResult Invoke(
-		bool is_priority,
-		std::pmr::memory_resource* args_rsrc,
-		TypeID typeID,
-		StrID methodID,
-		void* result_buffer,
+	// Variable
+	// 1. object variable and static
+	// 2. object const
+	// for_each(visit) calls visit(methodinfo) on the self overloads of a type in order, until it returns true
+	// - ranks every candidate in one pass
+	// - returns true at the first priority compatible overload (same, T <- &&{T}, &&{T} <- T)
+	// - meanwhile rst keeps the first compatible overload and its path
+	template<typename ForEach>
+	static bool RankOverloads(
+		MethodSearchMode mode,
 		std::span<const TypeID> argTypeIDs,
-		ArgsBuffer args_buffer)
+		std::span<const BaseInfo* const> path,
+		MethodResolution& rst,
+		ForEach&& for_each)
 	{
-		assert(Mngr->GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
+		auto rank = [&](const auto& filter) {
+			return for_each([&](const MethodInfo& methodinfo) {
+				const auto& methodptr = methodinfo.methodptr;
+				if (!filter(methodptr))
+					return false;
 
-		auto typetarget = Mngr->typeinfos.find(typeID);
+				if (IsPriorityCompatible(methodptr.GetParamList(), argTypeIDs)) {
+					rst.methodinfo = &methodinfo;
+					rst.path.assign(path.begin(), path.end());
+					return true;
+				}
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+				if (!rst.methodinfo && Mngr->IsCompatible(methodptr.GetParamList(), argTypeIDs)) {
+					rst.methodinfo = &methodinfo;
+					rst.path.assign(path.begin(), path.end());
+				}
 
-		const auto& typeinfo = typetarget->second;
+				return false;
+			});
+		};
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (mtarget->second.methodptr.IsStatic()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-			{
-				ConstructedArgumentsGuard guard{ args_rsrc, mtarget->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-				return {
-					true,
-					mtarget->second.methodptr.GetResultDesc().typeID,
-					std::move(mtarget->second.methodptr.Invoke(result_buffer, guard.GetArgsBuffer()))
-				};
-			}
+		switch (mode)
+		{
+		case MethodSearchMode::Static:
+			return rank([](const MethodPtr& methodptr) { return methodptr.IsStatic(); });
+		case MethodSearchMode::Const:
+			return rank([](const MethodPtr& methodptr) { return !methodptr.IsMemberVariable(); });
+		case MethodSearchMode::Variable:
+			return rank([](const MethodPtr& methodptr) { return !methodptr.IsMemberConst(); })
+				|| rank([](const MethodPtr& methodptr) { return methodptr.IsMemberConst(); });
+		default:
+			assert(false);
+			return false;
 		}
+	}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = Invoke(is_priority, args_rsrc, baseID, methodID, result_buffer, argTypeIDs, args_buffer);
-			if (rst.success)
-				return rst;
-		}
+	// depth-first, path records the bases on the way
+	// returns true at the first priority compatible overload, rst may hold a compatible one otherwise
+	static bool ResolveOverload(
+		MethodSearchMode mode,
+		TypeID typeID,
+		StrID methodID,
+		std::span<const TypeID> argTypeIDs,
+		std::vector<const BaseInfo*>& path,
+		MethodResolution& rst)
+	{
+		TypeInfoView typeinfo{ typeID };
 
-		return {};
+		if (!typeinfo)
+			return false;
+
+		if (RankOverloads(mode, argTypeIDs, path, rst, [&](const auto& visit) {
+			return typeinfo.AnyMethod(methodID, visit);
+		}))
+			return true;
+
+		return typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
+			path.push_back(&baseinfo);
+			bool found = ResolveOverload(mode, baseID, methodID, argTypeIDs, path, rst);
+			path.pop_back();
+			return found;
+		});
 	}
 
-	static InvokeResult Invoke(
-		bool is_priority,
-		std::pmr::memory_resource* args_rsrc,
-		ConstObjectPtr obj,
+	// frozen: one probe into the flattened methods of the type, same order as the depth-first search
+	static bool ResolveOverload(
+		MethodSearchMode mode,
+		const FrozenTypeInfo& ftypeinfo,
 		StrID methodID,
-		void* result_buffer,
 		std::span<const TypeID> argTypeIDs,
-		ArgsBuffer args_buffer)
+		MethodResolution& rst)
 	{
-		assert(Mngr->GetDereferenceProperty(obj.GetID()) == DereferenceProperty::NotReference);
+		const auto* overloads = ftypeinfo.flat_methodinfos.Find(methodID);
+		if (!overloads)
+			return false;
 
-		auto typetarget = Mngr->typeinfos.find(obj.GetID());
+		auto iter = overloads->begin();
+		while (iter != overloads->end()) {
+			// the overloads of a type share the path
+			const auto path = iter->path;
+			auto group_end = std::find_if(iter, overloads->end(), [&](const FlatMethod& flatmethod) {
+				return flatmethod.path.data() != path.data() || flatmethod.path.size() != path.size();
+			});
+
+			if (RankOverloads(mode, argTypeIDs, path, rst, [&](const auto& visit) {
+				for (auto cur = iter; cur != group_end; ++cur) {
+					if (visit(*cur->methodinfo))
+						return true;
+				}
+				return false;
+			}))
+				return true;
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+			iter = group_end;
+		}
 
-		const auto& typeinfo = typetarget->second;
+		return false;
+	}
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (!mtarget->second.methodptr.IsMemberVariable()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-			{
-				ConstructedArgumentsGuard guard{ args_rsrc, mtarget->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-				return {
-					true,
-					mtarget->second.methodptr.GetResultDesc().typeID,
-					std::move(mtarget->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer()))
-				};
-			}
-		}
+	static const void* StaticCast_DerivedToMethodType(const MethodResolution& resolution, const void* obj) noexcept {
+		for (const BaseInfo* baseinfo : resolution.path)
+			obj = baseinfo->StaticCast_DerivedToBase(obj);
+		return obj;
+	}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = Invoke(
-				is_priority, args_rsrc,
-				ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) },
-				methodID, result_buffer, argTypeIDs, args_buffer
-			);
-			if (rst.success)
-				return rst;
+	// rst: the result of the method, a Task<T> is awaited
+	static Task<SharedObject> AwaitTask(SharedObject rst) {
+		if (!rst || !Mngr->IsDerivedFrom(rst.GetID(), TypeID_of<TaskBase>))
+			co_return rst;
+
+		const TaskBase& task = Mngr->StaticCast_DerivedToBase(rst.AsObjectPtr(), TypeID_of<TaskBase>).As<TaskBase>();
+		co_await task;
+		co_return task.TakeResult();
+	}
+
+	// depth-first, path records the bases on the way
+	static const FieldInfo* FindField(TypeID typeID, StrID fieldID, std::vector<const BaseInfo*>& path) {
+		TypeInfoView typeinfo{ typeID };
+		if (!typeinfo)
+			return nullptr;
+
+		if (auto fieldinfo = typeinfo.FindField(fieldID))
+			return fieldinfo;
+
+		const FieldInfo* rst = nullptr;
+		typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
+			path.push_back(&baseinfo);
+			rst = FindField(baseID, fieldID, path);
+			if (rst)
+				return true;
+			path.pop_back();
+			return false;
+		});
+		return rst;
+	}
+
+	// frozen: first self or inherited field named fieldID with pred(fieldptr)
+	template<typename Pred>
+	static const FlatField* FindFlatField(const FrozenTypeInfo& ftypeinfo, StrID fieldID, Pred&& pred) {
+		const auto* fields = ftypeinfo.flat_fieldinfos.Find(fieldID);
+		if (!fields)
+			return nullptr;
+
+		for (const FlatField& field : *fields) {
+			if (pred(field.fieldinfo->fieldptr))
+				return &field;
 		}
+		return nullptr;
+	}
 
-		return {};
+	// constant offset through the bases with one, casts from the first base without an offset on
+	static const void* StaticCast_DerivedToFieldType(const FlatField& field, const void* obj) noexcept {
+		if (!obj)
+			return nullptr;
+
+		obj = forward_offset(obj, field.offset);
+		for (const BaseInfo* baseinfo : field.path)
+			obj = baseinfo->StaticCast_DerivedToBase(obj);
+		return obj;
 	}
 
-	static InvokeResult Invoke(
-		bool is_priority,
+	// obj: nullptr for static method
+	static Destructor CallMethod(
+		const MethodResolution& resolution,
 		std::pmr::memory_resource* args_rsrc,
-		ObjectPtr obj,
-		StrID methodID,
+		const void* obj,
 		void* result_buffer,
-		std::span<const TypeID> argTypeIDs,
 		ArgsBuffer args_buffer)
 	{
-		assert(Mngr->GetDereferenceProperty(obj.GetID()) == DereferenceProperty::NotReference);
+		assert(resolution);
+		const auto& methodptr = resolution.methodinfo->methodptr;
 
-		auto typetarget = Mngr->typeinfos.find(obj.GetID());
+		auto invoke = [&](ArgsBuffer buffer) {
+			if (methodptr.IsStatic())
+				return methodptr.Invoke(result_buffer, buffer);
 
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+			const void* base = StaticCast_DerivedToMethodType(resolution, obj);
+			if (methodptr.IsMemberConst())
+				return methodptr.Invoke(base, result_buffer, buffer);
+			else
+				return methodptr.Invoke(const_cast<void*>(base), result_buffer, buffer);
+		};
 
-		const auto& typeinfo = typetarget->second;
+		if (resolution.plan.IsPassThrough())
+			return invoke(args_buffer);
 
-		auto common_mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
+		ArgumentConversionGuard guard{ args_rsrc, resolution.plan, args_buffer };
+		return invoke(guard.GetArgsBuffer());
+	}
 
-		{ // 1. object variable and static
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (!iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					ConstructedArgumentsGuard guard{ args_rsrc, iter->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-					return {
-						true,
-						iter->second.methodptr.GetResultDesc().typeID,
-						iter->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer())
-					};
-				}
-			}
-		}
+	// a resolution of a batch, the path to the method's type folded into a CastPath
+	// - the resolution is copied, a method of the batch may clear the unfrozen cache (e.g. AddMethod)
+	class BatchTarget {
+	public:
+		BatchTarget(TypeID typeID, const MethodResolution& resolution) :
+			typeID{ typeID },
+			resolution{ resolution.methodinfo, {}, resolution.plan },
+			cast{ CastPath::FromPath(resolution.path) } {}
 
-		{ // 2. object const
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					ConstructedArgumentsGuard guard{ args_rsrc, iter->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-					return {
-						true,
-						iter->second.methodptr.GetResultDesc().typeID,
-						iter->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer())
-					};
-				}
-			}
-		}
+		TypeID GetTypeID() const noexcept { return typeID; }
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = Invoke(
-				is_priority, args_rsrc,
-				ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) },
-				methodID, result_buffer, argTypeIDs, args_buffer
-			);
-			if (rst.success)
-				return rst;
+		explicit operator bool() const noexcept { return static_cast<bool>(resolution); }
+
+		TypeID GetResultTypeID() const noexcept { return resolution.methodinfo->methodptr.GetResultDesc().typeID; }
+
+		Destructor Invoke(std::pmr::memory_resource* args_rsrc, void* obj, void* result_buffer, ArgsBuffer args_buffer) const {
+			assert(resolution);
+			// <resolution> has no path, CallMethod gets the object of the method's type
+			const void* base = resolution.methodinfo->methodptr.IsStatic() ? nullptr : cast.DerivedToBase(obj);
+			return CallMethod(resolution, args_rsrc, base, result_buffer, args_buffer);
 		}
 
-		return {};
+	private:
+		TypeID typeID;
+		MethodResolution resolution;
+		CastPath cast;
+	};
+
+	// call(result_buffer) -> Destructor, its result moves to a SharedObject
+	template<typename Call>
+	static SharedObject MakeSharedResult(const ResultDesc& rst_desc, std::pmr::memory_resource* rst_rsrc, Call&& call) {
+		if (rst_desc.IsVoid()) {
+			call(nullptr);
+			return {
+				{rst_desc.typeID, nullptr},
+				[](void* ptr) { assert(!ptr); }
+			};
+		}
+		else if (const auto* shape = Mngr->tregistry.GetShape(rst_desc.typeID); shape && shape->IsReference()) {
+			std::uint8_t buffer[sizeof(void*)];
+			call(buffer);
+			return {
+				{rst_desc.typeID, buffer_as<void*>(buffer)},
+				[](void* ptr) { assert(ptr); }
+			};
+		}
+		else {
+			void* result_buffer = rst_rsrc->allocate(rst_desc.size, rst_desc.alignment);
+			auto dtor = call(result_buffer);
+			return {
+				{rst_desc.typeID, result_buffer},
+				GenerateDeleteFunc(std::move(dtor), rst_rsrc, rst_desc.size, rst_desc.alignment)
+			};
+		}
 	}
 
+	// obj: nullptr for static method
 	static SharedObject MInvoke(
-		bool is_priority,
+		const MethodResolution& resolution,
 		std::pmr::memory_resource* args_rsrc,
-		TypeID typeID,
-		StrID methodID,
-		std::span<const TypeID> argTypeIDs,
+		const void* obj,
 		ArgsBuffer args_buffer,
 		std::pmr::memory_resource* rst_rsrc)
 	{
-		assert(Mngr->GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
-
-		auto typetarget = Mngr->typeinfos.find(typeID);
-
-		if (typetarget == Mngr->typeinfos.end())
+		assert(rst_rsrc);
+		if (!resolution)
 			return {};
 
-		const auto& typeinfo = typetarget->second;
+		return MakeSharedResult(resolution.methodinfo->methodptr.GetResultDesc(), rst_rsrc, [&](void* result_buffer) {
+			return CallMethod(resolution, args_rsrc, obj, result_buffer, args_buffer);
+		});
+	}
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (mtarget->second.methodptr.IsStatic()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-			{
-				const auto& methodptr = mtarget->second.methodptr;
-				const auto& rst_desc = methodptr.GetResultDesc();
-				ConstructedArgumentsGuard guard{ args_rsrc, mtarget->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-
-				if (rst_desc.IsVoid()) {
-					mtarget->second.methodptr.Invoke(nullptr, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, nullptr},
-						[](void* ptr) { assert(ptr); }
-					};
-				}
-				else if (type_name_is_reference(Mngr->tregistry.Nameof(rst_desc.typeID))) {
-					std::uint8_t buffer[sizeof(void*)];
-					mtarget->second.methodptr.Invoke(buffer, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, buffer_as<void*>(buffer)},
-						[](void* ptr) { assert(ptr); }
-					};
-				}
-				else {
-					void* result_buffer = rst_rsrc->allocate(rst_desc.size, rst_desc.alignment);
-					auto dtor = mtarget->second.methodptr.Invoke(result_buffer, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, result_buffer},
-						GenerateDeleteFunc(std::move(dtor), rst_rsrc, rst_desc.size, rst_desc.alignment)
-					};
+	// a resolved call owning the copies of its arguments (ReflMngr::CaptureCall)
+	struct CapturedCall {
+		MethodSearchMode mode;
+		const void* obj;
+		MethodHandle handle;
+		std::vector<void*> args;
+		// by value pointer arguments
+		std::vector<void*> pointers;
+		// of ReflMngr::New
+		std::vector<ObjectPtr> copies;
+		std::pmr::memory_resource* result_rsrc;
+
+		CapturedCall() = default;
+		CapturedCall(const CapturedCall&) = delete;
+		CapturedCall& operator=(const CapturedCall&) = delete;
+		~CapturedCall() { DeleteCopies(); }
+
+		void DeleteCopies() noexcept {
+			for (ObjectPtr copy : copies)
+				Mngr->Delete(copy);
+			copies.clear();
+		}
+
+		SharedObject Invoke() {
+			return MakeSharedResult(handle.GetResultDesc(), result_rsrc, [&](void* result_buffer) {
+				switch (mode)
+				{
+				case MethodSearchMode::Static:
+					return handle.Invoke(result_buffer, args.data());
+				case MethodSearchMode::Const:
+					return handle.Invoke(obj, result_buffer, args.data());
+				default:
+					return handle.Invoke(const_cast<void*>(obj), result_buffer, args.data());
 				}
-			}
+			});
 		}
+	};
+
+	// a scheduled call, shared by ReflMngr::ScheduleInvoke and the task
+	struct AsyncCall : CapturedCall {
+		std::promise<SharedObject> promise;
+
+		void Run() noexcept {
+			SharedObject rst;
+			std::exception_ptr error;
+			try {
+				rst = Invoke();
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = MInvoke(is_priority, args_rsrc, baseID, methodID, argTypeIDs, args_buffer, rst_rsrc);
-			if (rst.GetID())
-				return rst;
+			// the copies are gone once the future is ready
+			DeleteCopies();
+
+			if (error)
+				promise.set_exception(error);
+			else
+				promise.set_value(std::move(rst));
 		}
+	};
 
-		return nullptr;
+	// the frame owns the call, its copies outlive the method's Task<T>
+	static Task<SharedObject> AwaitCall(std::shared_ptr<CapturedCall> call) {
+		if (!call)
+			co_return SharedObject{};
+
+		co_return co_await AwaitTask(call->Invoke());
 	}
 
-	static SharedObject MInvoke(
-		bool is_priority,
+	static InvocableResult IsInvocable(const MethodResolution& resolution) {
+		if (!resolution)
+			return {};
+
+		return { true, resolution.methodinfo->methodptr.GetResultDesc() };
+	}
+
+	// call(args_buffer)
+	template<typename Func>
+	static Destructor CallWithArguments(
 		std::pmr::memory_resource* args_rsrc,
-		ConstObjectPtr obj,
-		StrID methodID,
-		std::span<const TypeID> argTypeIDs,
+		const ArgumentConversionPlan& plan,
 		ArgsBuffer args_buffer,
-		std::pmr::memory_resource* rst_rsrc)
+		Func&& call)
 	{
-		assert(rst_rsrc);
-		assert(Mngr->GetDereferenceProperty(obj.GetID()) == DereferenceProperty::NotReference);
+		if (plan.IsPassThrough())
+			return call(args_buffer);
 
-		auto typetarget = Mngr->typeinfos.find(obj.GetID());
+		ArgumentConversionGuard guard{ args_rsrc, plan, args_buffer };
+		return call(guard.GetArgsBuffer());
+	}
 
-		if (typetarget == Mngr->typeinfos.end())
+	// obj: nullptr for static method
+	static InvokeResult Invoke(
+		const MethodResolution& resolution,
+		std::pmr::memory_resource* args_rsrc,
+		const void* obj,
+		void* result_buffer,
+		ArgsBuffer args_buffer)
+	{
+		if (!resolution)
 			return {};
 
-		const auto& typeinfo = typetarget->second;
+		return {
+			true,
+			resolution.methodinfo->methodptr.GetResultDesc().typeID,
+			CallMethod(resolution, args_rsrc, obj, result_buffer, args_buffer)
+		};
+	}
 
-		auto mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
-		for (size_t i = 0; i < num; ++i, ++mtarget) {
-			if (!mtarget->second.methodptr.IsMemberVariable()
-				&& (is_priority ? IsPriorityCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)
-					: Mngr->IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs)))
-			{
-				const auto& methodptr = mtarget->second.methodptr;
-				const auto& rst_desc = methodptr.GetResultDesc();
-				ConstructedArgumentsGuard guard{ args_rsrc, mtarget->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-				if (rst_desc.IsVoid()) {
-					auto dtor = mtarget->second.methodptr.Invoke(obj.GetPtr(), nullptr, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, nullptr},
-						[](void* ptr) { assert(!ptr); }
-					};
-				}
-				else if (type_name_is_reference(Mngr->tregistry.Nameof(rst_desc.typeID))) {
-					std::uint8_t buffer[sizeof(void*)];
-					mtarget->second.methodptr.Invoke(obj.GetPtr(), buffer, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, buffer_as<void*>(buffer)},
-						[](void* ptr) { assert(ptr); }
-					};
-				}
-				else {
-					void* result_buffer = rst_rsrc->allocate(rst_desc.size, rst_desc.alignment);
-					auto dtor = mtarget->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer());
-					return {
-						{rst_desc.typeID, result_buffer},
-						GenerateDeleteFunc(std::move(dtor), rst_rsrc, rst_desc.size, rst_desc.alignment)
-					};
-				}
-			}
+	// first self ctor compatible with argTypeIDs, nullptr if not constructible
+	static const MethodInfo* FindConstructor(const TypeInfoView& typeinfo, std::span<const TypeID> argTypeIDs) {
+		return typeinfo.FindMethod(StrIDRegistry::MetaID::ctor, [&](const MethodPtr& methodptr) {
+			return methodptr.IsMemberVariable() && Mngr->IsCompatible(methodptr.GetParamList(), argTypeIDs);
+		});
+	}
+
+	// T{} | T{arg} (arg is a T) by the type traits, no ctor call
+	enum class TrivialConstruct : std::uint8_t {
+		None,
+		Zero, // value-initialization of a zero initializable type
+		Copy  // trivially copy constructible
+	};
+
+	struct ConstructorResolution {
+		TrivialConstruct trivial{ TrivialConstruct::None };
+		const MethodInfo* ctor{ nullptr };
+
+		explicit operator bool() const noexcept { return trivial != TrivialConstruct::None || ctor; }
+	};
+
+	// the only default ctor is the one of RegisterType<T> (T{}), not one added by the user
+	static bool HasOnlyTrivialDefaultConstructor(const TypeInfoView& typeinfo) {
+		std::size_t num_default_ctors = 0;
+		typeinfo.FindMethod(StrIDRegistry::MetaID::ctor, [&](const MethodPtr& methodptr) {
+			if (methodptr.IsMemberVariable() && methodptr.GetParamList().empty())
+				++num_default_ctors;
+			return num_default_ctors > 1;
+		});
+		return num_default_ctors == 1;
+	}
+
+	static ConstructorResolution ResolveConstructor(const TypeInfoView& typeinfo, TypeID typeID, std::span<const TypeID> argTypeIDs) {
+		const TypeTraits& traits = typeinfo->traits;
+		if (argTypeIDs.empty() && traits.is_zero_initializable && HasOnlyTrivialDefaultConstructor(typeinfo))
+			return { TrivialConstruct::Zero };
+		if (argTypeIDs.size() == 1 && traits.is_trivially_copy_constructible) {
+			const auto* shape = Mngr->tregistry.GetShape(argTypeIDs[0]);
+			if (argTypeIDs[0] == typeID || (shape && shape->raw == typeID))
+				return { TrivialConstruct::Copy };
 		}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = MInvoke(
-				is_priority, args_rsrc,
-				ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) },
-				methodID, argTypeIDs, args_buffer, rst_rsrc
-			);
-			if (rst.GetID())
-				return rst;
+		return { TrivialConstruct::None, FindConstructor(typeinfo, argTypeIDs) };
+	}
+
+	// self dtor, nullptr if not destructible
+	static const MethodInfo* FindDestructor(const TypeInfoView& typeinfo) {
+		return typeinfo.FindMethod(StrIDRegistry::MetaID::dtor, [&](const MethodPtr& methodptr) {
+			return methodptr.IsMemberConst() && Mngr->IsCompatible(methodptr.GetParamList(), {});
+		});
+	}
+
+	// object and std::shared_ptr's control block in one allocation (ReflMngr::MakeShared)
+	template<std::size_t N>
+	struct SharedObjectHolder {
+		// storage is left uninitialized
+		SharedObjectHolder() noexcept {}
+		~SharedObjectHolder() {
+			if (dtor)
+				dtor->Invoke(static_cast<const void*>(storage), nullptr, nullptr);
 		}
 
+		// set once the object is constructed
+		const MethodPtr* dtor{ nullptr };
+		alignas(std::max_align_t) std::byte storage[N];
+	};
+
+	using SharedObjectAllocator = std::pmr::polymorphic_allocator<std::byte>;
+
+	struct SharedObjectBlock {
+		// aliases the storage
+		SharedBuffer buffer;
+		const MethodPtr** dtor;
+	};
+
+	template<std::size_t N>
+	static SharedObjectBlock AllocateSharedObject(std::pmr::memory_resource* rsrc) {
+		auto holder = std::allocate_shared<SharedObjectHolder<N>>(SharedObjectAllocator{ rsrc });
+		const MethodPtr** dtor = &holder->dtor;
+		void* storage = holder->storage;
+		return { SharedBuffer{ std::move(holder), storage }, dtor };
+	}
+
+	// bytes std::allocate_shared asks for a SharedObjectHolder<N>, the block size of its pool
+	template<std::size_t N>
+	static std::size_t SharedObjectBlockSize() {
+		static const std::size_t size = [] {
+			class Probe : public std::pmr::memory_resource {
+			public:
+				std::size_t max_bytes{ 0 };
+			private:
+				void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+					max_bytes = std::max(max_bytes, bytes);
+					return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+				}
+				void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+					std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+				}
+				bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+			};
+			Probe probe;
+			AllocateSharedObject<N>(&probe);
+			return probe.max_bytes;
+		}();
+		return size;
+	}
+
+	struct SharedObjectClass {
+		std::size_t size;
+		SharedObjectBlock(*allocate)(std::pmr::memory_resource* rsrc);
+		std::size_t(*block_size)();
+	};
+
+	template<std::size_t... Ns>
+	static constexpr std::array<SharedObjectClass, sizeof...(Ns)> shared_object_classes = {
+		SharedObjectClass{ Ns, &AllocateSharedObject<Ns>, &SharedObjectBlockSize<Ns> }...
+	};
+
+	// nullptr if the object is too large or over-aligned, then it takes two allocations
+	static const SharedObjectClass* FindSharedObjectClass(std::size_t size, std::size_t alignment) noexcept {
+		if (alignment > alignof(std::max_align_t))
+			return nullptr;
+
+		for (const auto& c : shared_object_classes<16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024>) {
+			if (size <= c.size)
+				return &c;
+		}
 		return nullptr;
 	}
 
-	static SharedObject MInvoke(
-		bool is_priority,
+	static void CallConstructor(
+		const MethodInfo& ctor,
 		std::pmr::memory_resource* args_rsrc,
-		ObjectPtr obj,
-		StrID methodID,
+		void* obj,
 		std::span<const TypeID> argTypeIDs,
-		ArgsBuffer args_buffer,
-		std::pmr::memory_resource* rst_rsrc)
+		ArgsBuffer args_buffer)
 	{
-		assert(rst_rsrc);
-		assert(Mngr->GetDereferenceProperty(obj.GetID()) == DereferenceProperty::NotReference);
-
-		auto typetarget = Mngr->typeinfos.find(obj.GetID());
-
-		if (typetarget == Mngr->typeinfos.end())
-			return {};
+		auto plan = CompileArgumentConversionPlan(ctor.methodptr.GetParamList(), argTypeIDs);
+		CallWithArguments(args_rsrc, plan, args_buffer, [&](ArgsBuffer buffer) {
+			return ctor.methodptr.Invoke(obj, nullptr, buffer);
+		});
+	}
 
-		const auto& typeinfo = typetarget->second;
+	static void Construct(
+		const ConstructorResolution& resolution,
+		std::size_t size,
+		void* obj,
+		std::span<const TypeID> argTypeIDs,
+		ArgsBuffer args_buffer)
+	{
+		switch (resolution.trivial)
+		{
+		case TrivialConstruct::Zero:
+			std::memset(obj, 0, size);
+			break;
+		case TrivialConstruct::Copy:
+			std::memcpy(obj, args_buffer[0], size);
+			break;
+		default:
+			assert(resolution.ctor);
+			CallConstructor(*resolution.ctor, &ScratchArena::ArgumentArena(), obj, argTypeIDs, args_buffer);
+			break;
+		}
+	}
 
-		auto common_mtarget = typeinfo.methodinfos.find(methodID);
-		size_t num = typeinfo.methodinfos.count(methodID);
+	// encodes the bases first, the node is the union of theirs
+	static const TypeHierarchy::Node& EncodeHierarchy(TypeHierarchy& hierarchy, TypeID typeID) {
+		if (auto node = hierarchy.Find(typeID))
+			return *node;
 
-		{ // 1. object variable and static
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (!iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					const auto& methodptr = iter->second.methodptr;
-					const auto& rst_desc = methodptr.GetResultDesc();
-					ConstructedArgumentsGuard guard{ args_rsrc, iter->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-
-					if (rst_desc.IsVoid()) {
-						auto dtor = iter->second.methodptr.Invoke(obj.GetPtr(), nullptr, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, nullptr},
-							[](void* ptr) { assert(!ptr); }
-						};
-					}
-					else if (type_name_is_reference(Mngr->tregistry.Nameof(rst_desc.typeID))) {
-						std::uint8_t buffer[sizeof(void*)];
-						iter->second.methodptr.Invoke(obj.GetPtr(), buffer, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, buffer_as<void*>(buffer)},
-							[](void* ptr) { assert(ptr); }
-						};
-					}
-					else {
-						void* result_buffer = rst_rsrc->allocate(rst_desc.size, rst_desc.alignment);
-						auto dtor = iter->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, result_buffer},
-							GenerateDeleteFunc(std::move(dtor), rst_rsrc, rst_desc.size, rst_desc.alignment)
-						};
-					}
-				}
-			}
+		TypeHierarchy::Node bases{ 0, {} };
+		if (TypeInfoView typeinfo{ typeID }) {
+			typeinfo.AnyBase([&](TypeID baseID, const BaseInfo&) {
+				bases.Merge(EncodeHierarchy(hierarchy, baseID));
+				return false;
+			});
 		}
 
-		{ // 2. object const
-			auto iter = common_mtarget;
-			for (size_t i = 0; i < num; ++i, ++iter) {
-				if (iter->second.methodptr.IsMemberConst()
-					&& (is_priority ? IsPriorityCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)
-						: Mngr->IsCompatible(iter->second.methodptr.GetParamList(), argTypeIDs)))
-				{
-					const auto& methodptr = iter->second.methodptr;
-					const auto& rst_desc = methodptr.GetResultDesc();
-					ConstructedArgumentsGuard guard{ args_rsrc, iter->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-					if (rst_desc.IsVoid()) {
-						auto dtor = iter->second.methodptr.Invoke(obj.GetPtr(), nullptr, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, nullptr},
-							[](void* ptr) { assert(!ptr); }
-						};
-					}
-					else if (type_name_is_reference(Mngr->tregistry.Nameof(rst_desc.typeID))) {
-						std::uint8_t buffer[sizeof(void*)];
-						iter->second.methodptr.Invoke(obj.GetPtr(), buffer, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, buffer_as<void*>(buffer)},
-							[](void* ptr) { assert(ptr); }
-						};
-					}
-					else {
-						void* result_buffer = rst_rsrc->allocate(rst_desc.size, rst_desc.alignment);
-						auto dtor = iter->second.methodptr.Invoke(obj.GetPtr(), result_buffer, guard.GetArgsBuffer());
-						return {
-							{rst_desc.typeID, result_buffer},
-							GenerateDeleteFunc(std::move(dtor), rst_rsrc, rst_desc.size, rst_desc.alignment)
-						};
-					}
-				}
-			}
-		}
+		return hierarchy.Insert(typeID, std::move(bases.bases));
+	}
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-			auto rst = MInvoke(
-				is_priority, args_rsrc,
-				ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) },
-				methodID, argTypeIDs, args_buffer, rst_rsrc
-			);
-			if (rst.GetID())
-				return rst;
-		}
+	// depth-first, the derived to base casts from typeID to baseID (excluded)
+	static bool FindBasePath(TypeID typeID, TypeID baseID, std::vector<const BaseInfo*>& path) {
+		TypeInfoView typeinfo{ typeID };
+		if (!typeinfo)
+			return false;
 
-		return nullptr;
+		return typeinfo.AnyBase([&](TypeID ID, const BaseInfo& baseinfo) {
+			path.push_back(&baseinfo);
+			if (ID == baseID || FindBasePath(ID, baseID, path))
+				return true;
+			path.pop_back();
+			return false;
+		});
 	}
 
 	static bool ForEachTypeID(
@@ -806,24 +1031,20 @@ namespace Ubpa::UDRefl::details {
 		if (!func(typeID))
 			return false;
 
-		auto target = ReflMngr::Instance().typeinfos.find(typeID);
+		TypeInfoView typeinfo{ typeID };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		const auto& typeinfo = target->second;
-
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachTypeID(baseID, func, visitedVBs))
-				return false;
-		}
-		return true;
+			return !ForEachTypeID(baseID, func, visitedVBs);
+		});
 	}
 
 	static bool ForEachTypeInfo(
@@ -831,28 +1052,23 @@ namespace Ubpa::UDRefl::details {
 		const std::function<bool(TypeRef)>& func,
 		std::set<TypeID>& visitedVBs)
 	{
-		auto target = ReflMngr::Instance().typeinfos.find(typeID);
+		TypeInfoView typeinfo{ typeID };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		auto& typeinfo = target->second;
-
-		if (!func({ typeID, typeinfo }))
+		if (!func(typeinfo.Ref(typeID)))
 			return false;
 
-		for (auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachTypeInfo(baseID, func, visitedVBs))
-				return false;
-		}
-
-		return true;
+			return !ForEachTypeInfo(baseID, func, visitedVBs);
+		});
 	}
 
 	static bool ForEachRWVar(
@@ -863,32 +1079,30 @@ namespace Ubpa::UDRefl::details {
 		if (!obj.Valid())
 			return true;
 
-		auto target = ReflMngr::Instance().typeinfos.find(obj.GetID());
+		TypeInfoView typeinfo{ obj.GetID() };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		auto& typeinfo = target->second;
+		const TypeRef type = typeinfo.Ref(obj.GetID());
 
-		for (auto& [fieldID, fieldInfo] : typeinfo.fieldinfos) {
-			if (!fieldInfo.fieldptr.IsConst()) {
-				if (!func({ obj.GetID(), typeinfo }, { fieldID, fieldInfo }, fieldInfo.fieldptr.RWVar(obj.GetPtr())))
-					return false;
-			}
-		}
+		bool stopped = typeinfo.AnyField([&](StrID fieldID, FieldInfo& fieldinfo) {
+			if (fieldinfo.fieldptr.IsConst())
+				return false;
+			return !func(type, { fieldID, fieldinfo }, fieldinfo.fieldptr.RWVar(obj.GetPtr()));
+		});
+		if (stopped)
+			return false;
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachRWVar(ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, func, visitedVBs))
-				return false;
-		}
-
-		return true;
+			return !ForEachRWVar(ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, func, visitedVBs);
+		});
 	}
 
 	static bool ForEachRVar(
@@ -899,30 +1113,28 @@ namespace Ubpa::UDRefl::details {
 		if (!obj.Valid())
 			return true;
 
-		auto target = ReflMngr::Instance().typeinfos.find(obj.GetID());
+		TypeInfoView typeinfo{ obj.GetID() };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		auto& typeinfo = target->second;
+		const TypeRef type = typeinfo.Ref(obj.GetID());
 
-		for (auto& [fieldID, fieldInfo] : typeinfo.fieldinfos) {
-			if (!func({ obj.GetID(), typeinfo }, { fieldID, fieldInfo }, fieldInfo.fieldptr.RVar(obj.GetPtr())))
-				return false;
-		}
+		bool stopped = typeinfo.AnyField([&](StrID fieldID, FieldInfo& fieldinfo) {
+			return !func(type, { fieldID, fieldinfo }, fieldinfo.fieldptr.RVar(obj.GetPtr()));
+		});
+		if (stopped)
+			return false;
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachRVar(ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, func, visitedVBs))
-				return false;
-		}
-
-		return true;
+			return !ForEachRVar(ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, func, visitedVBs);
+		});
 	}
 
 	static bool ForEachRWVar(
@@ -933,32 +1145,30 @@ namespace Ubpa::UDRefl::details {
 		if (!typeID)
 			return true;
 
-		auto target = ReflMngr::Instance().typeinfos.find(typeID);
+		TypeInfoView typeinfo{ typeID };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		auto& typeinfo = target->second;
+		const TypeRef type = typeinfo.Ref(typeID);
 
-		for (auto& [fieldID, fieldInfo] : typeinfo.fieldinfos) {
-			if (fieldInfo.fieldptr.IsUnowned() && !fieldInfo.fieldptr.IsConst()) {
-				if (!func({ typeID, typeinfo }, { fieldID, fieldInfo }, fieldInfo.fieldptr.RWVar()))
-					return false;
-			}
-		}
+		bool stopped = typeinfo.AnyField([&](StrID fieldID, FieldInfo& fieldinfo) {
+			if (!fieldinfo.fieldptr.IsUnowned() || fieldinfo.fieldptr.IsConst())
+				return false;
+			return !func(type, { fieldID, fieldinfo }, fieldinfo.fieldptr.RWVar());
+		});
+		if (stopped)
+			return false;
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachRWVar(baseID, func, visitedVBs))
-				return false;
-		}
-
-		return true;
+			return !ForEachRWVar(baseID, func, visitedVBs);
+		});
 	}
 
 	static bool ForEachRVar(
@@ -969,32 +1179,30 @@ namespace Ubpa::UDRefl::details {
 		if (!typeID)
 			return true;
 
-		auto target = ReflMngr::Instance().typeinfos.find(typeID);
+		TypeInfoView typeinfo{ typeID };
 
-		if (target == ReflMngr::Instance().typeinfos.end())
+		if (!typeinfo)
 			return true;
 
-		auto& typeinfo = target->second;
+		const TypeRef type = typeinfo.Ref(typeID);
 
-		for (auto& [fieldID, fieldInfo] : typeinfo.fieldinfos) {
-			if (fieldInfo.fieldptr.IsUnowned()) {
-				if (!func({ typeID, typeinfo }, { fieldID, fieldInfo }, fieldInfo.fieldptr.RVar()))
-					return false;
-			}
-		}
+		bool stopped = typeinfo.AnyField([&](StrID fieldID, FieldInfo& fieldinfo) {
+			if (!fieldinfo.fieldptr.IsUnowned())
+				return false;
+			return !func(type, { fieldID, fieldinfo }, fieldinfo.fieldptr.RVar());
+		});
+		if (stopped)
+			return false;
 
-		for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
+		return !typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
 			if (baseinfo.IsVirtual()) {
 				if (visitedVBs.find(baseID) != visitedVBs.end())
-					continue;
+					return false;
 				visitedVBs.insert(baseID);
 			}
 
-			if (!ForEachRVar(baseID, func, visitedVBs))
-				return false;
-		}
-
-		return true;
+			return !ForEachRVar(baseID, func, visitedVBs);
+		});
 	}
 }
 
@@ -1072,6 +1280,8 @@ ReflMngr::ReflMngr() {
 }
 
 void ReflMngr::Clear() noexcept {
+	Unfreeze();
+
 	// field attrs
 	for (auto& [typeID, typeinfo] : typeinfos) {
 		for (auto& [fieldID, fieldinfo] : typeinfo.fieldinfos)
@@ -1095,13 +1305,180 @@ void ReflMngr::Clear() noexcept {
 	}
 
 	typeinfos.clear();
+	method_resolution_cache.Clear();
+	cast_path_cache.Clear();
+	type_hierarchy.Clear();
+	epochs.Collect();
 }
 
 ReflMngr::~ReflMngr() {
 	Clear();
 }
 
-TypeID ReflMngr::RegisterType(std::string_view name, size_t size, size_t alignment) {
+bool ReflMngr::IsRegistered(TypeID typeID) const noexcept {
+	if (IsFrozen()) {
+		ReadGuard guard;
+		return GetFrozenTypeInfo(typeID) != nullptr;
+	}
+
+	return typeinfos.find(typeID) != typeinfos.end();
+}
+
+ReflMngr::WriteGuard::WriteGuard(ReflMngr& mngr) :
+	mngr{ mngr }
+{
+	mngr.write_mutex.lock();
+	++mngr.write_depth;
+}
+
+ReflMngr::WriteGuard::~WriteGuard() {
+	if (--mngr.write_depth == 0 && mngr.write_modified) {
+		mngr.write_modified = false;
+		if (mngr.frozen_snapshot_owner)
+			mngr.Publish();
+	}
+	mngr.write_mutex.unlock();
+}
+
+bool ReflMngr::Publish() {
+	auto snapshot = std::make_shared<FrozenSnapshot>();
+	const bool success = snapshot->registry.Build(typeinfos);
+	if (!success)
+		snapshot.reset(); // readers fall back to <typeinfos>
+
+	// readers entering from now on see the new snapshot
+	frozen_snapshot.store(snapshot.get(), std::memory_order_seq_cst);
+	epochs.Retire(std::move(frozen_snapshot_owner));
+	frozen_snapshot_owner = std::move(snapshot);
+
+	epochs.Collect();
+	return success;
+}
+
+bool ReflMngr::Freeze() {
+	WriteGuard guard{ *this };
+	if (frozen_snapshot_owner)
+		return true;
+
+	return Publish();
+}
+
+void ReflMngr::Unfreeze() noexcept {
+	{
+		WriteGuard guard{ *this };
+		if (!frozen_snapshot_owner)
+			return;
+
+		frozen_snapshot.store(nullptr, std::memory_order_seq_cst);
+		epochs.Retire(std::move(frozen_snapshot_owner));
+		frozen_snapshot_owner.reset();
+	}
+
+	epochs.Synchronize();
+}
+
+const FrozenTypeInfo* ReflMngr::GetFrozenTypeInfo(TypeID typeID) const noexcept {
+	const FrozenSnapshot* snapshot = frozen_snapshot.load(std::memory_order_seq_cst);
+	if (!snapshot)
+		return nullptr;
+
+	return snapshot->registry.FindTypeInfo(typeID);
+}
+
+void ReflMngr::ClearMethodResolutionCache() const {
+	// frozen, <typeinfos> only changes through the modifiers, which publish an empty cache
+	method_resolution_cache.Clear();
+}
+
+const CastPath& ReflMngr::ResolveCastPath(TypeID derivedID, TypeID baseID) const {
+	// frozen, the caller holds a ReadGuard, so the snapshot and its cache outlive the result
+	const FrozenSnapshot* snapshot = frozen_snapshot.load(std::memory_order_seq_cst);
+	CastPathCache& cache = snapshot ? snapshot->cast_path_cache : cast_path_cache;
+
+	if (auto cached = cache.Find(derivedID, baseID))
+		return *cached;
+
+	std::vector<const BaseInfo*> bases;
+	if (derivedID != baseID && !details::FindBasePath(derivedID, baseID, bases))
+		return cache.Insert(derivedID, baseID, CastPath{});
+
+	return cache.Insert(derivedID, baseID, CastPath::FromPath(std::move(bases)));
+}
+
+void ReflMngr::ClearCastPathCache() const {
+	// frozen, <typeinfos> only changes through the modifiers, which publish an empty cache
+	cast_path_cache.Clear();
+}
+
+bool ReflMngr::IsDerivedFrom(TypeID derivedID, TypeID baseID) const {
+	if (derivedID == baseID)
+		return true;
+
+	ReadGuard guard;
+
+	const FrozenSnapshot* snapshot = frozen_snapshot.load(std::memory_order_seq_cst);
+	TypeHierarchy& hierarchy = snapshot ? snapshot->type_hierarchy : type_hierarchy;
+
+	// the bases of derivedID are encoded with it
+	const TypeHierarchy::Node& derived = details::EncodeHierarchy(hierarchy, derivedID);
+	const TypeHierarchy::Node* base = hierarchy.Find(baseID);
+
+	return base && derived.IsDerivedFrom(*base);
+}
+
+void ReflMngr::ClearTypeHierarchy() const {
+	// frozen, <typeinfos> only changes through the modifiers, which publish an empty encoding
+	type_hierarchy.Clear();
+}
+
+const MethodResolution& ReflMngr::ResolveOverload(
+	MethodSearchMode mode,
+	TypeID typeID,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs) const
+{
+	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
+
+	// frozen, the caller holds a ReadGuard, so the snapshot and its cache outlive the result
+	const FrozenSnapshot* snapshot = frozen_snapshot.load(std::memory_order_seq_cst);
+	MethodResolutionCache& cache = snapshot ? snapshot->method_resolution_cache : method_resolution_cache;
+
+	if (auto cached = cache.Find(typeID, methodID, mode, argTypeIDs))
+		return *cached;
+
+	// one pass over the whole hierarchy
+	// 1. priority compatible (same, T <- &&{T}, &&{T} <- T)
+	// 2. compatible
+	MethodResolution rst;
+	if (const auto* ftypeinfo = snapshot ? snapshot->registry.FindTypeInfo(typeID) : nullptr)
+		details::ResolveOverload(mode, *ftypeinfo, methodID, argTypeIDs, rst);
+	else {
+		std::vector<const BaseInfo*> path;
+		details::ResolveOverload(mode, typeID, methodID, argTypeIDs, path, rst);
+	}
+
+	if (rst.methodinfo)
+		rst.plan = details::CompileArgumentConversionPlan(rst.methodinfo->methodptr.GetParamList(), argTypeIDs);
+
+	return cache.Insert(typeID, methodID, mode, argTypeIDs, std::move(rst));
+}
+
+MethodHandle ReflMngr::ResolveMethod(
+	TypeID typeID,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	MethodSearchMode mode) const
+{
+	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
+		return ResolveMethod(Dereference(typeID), methodID, argTypeIDs, mode);
+
+	ReadGuard guard;
+	return { typeID, ResolveOverload(mode, typeID, methodID, argTypeIDs) };
+}
+
+TypeID ReflMngr::RegisterType(std::string_view name, size_t size, size_t alignment, TypeTraits traits) {
+	WriteGuard guard{ *this };
+
 	TypeID ID{ name };
 
 	auto target = typeinfos.find(ID);
@@ -1109,12 +1486,17 @@ TypeID ReflMngr::RegisterType(std::string_view name, size_t size, size_t alignme
 		return ID;
 
 	tregistry.Register(ID, name);
-	typeinfos.emplace_hint(target, ID, TypeInfo{ size,alignment });
+	TypeInfo typeinfo{ size,alignment };
+	typeinfo.traits = traits;
+	typeinfos.emplace_hint(target, ID, std::move(typeinfo));
+	guard.Modified();
 
 	return ID;
 }
 
 StrID ReflMngr::AddField(TypeID typeID, std::string_view name, FieldInfo fieldinfo) {
+	WriteGuard guard{ *this };
+
 	auto ttarget = typeinfos.find(typeID);
 	if (ttarget == typeinfos.end())
 		return {};
@@ -1124,10 +1506,13 @@ StrID ReflMngr::AddField(TypeID typeID, std::string_view name, FieldInfo fieldin
 	if (ftarget != typeinfo.fieldinfos.end())
 		return {};
 	typeinfo.fieldinfos.emplace_hint(ftarget, fieldID, std::move(fieldinfo));
+	guard.Modified();
 	return fieldID;
 }
 
 StrID ReflMngr::AddMethod(TypeID typeID, std::string_view name, MethodInfo methodinfo) {
+	WriteGuard guard{ *this };
+
 	auto ttarget = typeinfos.find(typeID);
 	if (ttarget == typeinfos.end())
 		return {};
@@ -1145,10 +1530,14 @@ StrID ReflMngr::AddMethod(TypeID typeID, std::string_view name, MethodInfo metho
 	if (!flag)
 		return {};
 	typeinfo.methodinfos.emplace(methodID, std::move(methodinfo));
+	method_resolution_cache.Clear();
+	guard.Modified();
 	return methodID;
 }
 
 bool ReflMngr::AddBase(TypeID derivedID, TypeID baseID, BaseInfo baseinfo) {
+	WriteGuard guard{ *this };
+
 	auto ttarget = typeinfos.find(derivedID);
 	if (ttarget == typeinfos.end())
 		return false;
@@ -1157,10 +1546,16 @@ bool ReflMngr::AddBase(TypeID derivedID, TypeID baseID, BaseInfo baseinfo) {
 	if (btarget != typeinfo.baseinfos.end())
 		return false;
 	typeinfo.baseinfos.emplace_hint(btarget, baseID, std::move(baseinfo));
+	method_resolution_cache.Clear();
+	cast_path_cache.Clear();
+	type_hierarchy.Clear();
+	guard.Modified();
 	return true;
 }
 
 bool ReflMngr::AddAttr(TypeID typeID, const Attr& attr) {
+	WriteGuard guard{ *this };
+
 	auto ttarget = typeinfos.find(typeID);
 	if (ttarget == typeinfos.end())
 		return false;
@@ -1189,25 +1584,26 @@ bool ReflMngr::AlignedFree(void* ptr) const {
 }
 
 ObjectPtr ReflMngr::New(TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
-	if (!IsConstructible(typeID, argTypeIDs))
-		return nullptr;
-
-	const auto& typeinfo = typeinfos.at(typeID);
+	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
 
-	void* buffer = typeinfo.alignment <= std::alignment_of_v<std::max_align_t> ?
-		Malloc(typeinfo.size)
-		: AlignedMalloc(typeinfo.size, typeinfo.alignment);
+	// resolve the ctor once, then allocate
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
+		return nullptr;
 
-	if (!buffer)
+	auto ctor = details::ResolveConstructor(typeinfo, typeID, argTypeIDs);
+	if (!ctor)
 		return nullptr;
 
-	ObjectPtr obj{ typeID, buffer };
-	bool success = Construct(obj, argTypeIDs, args_buffer);
-	
-	if (success)
-		return obj;
+	void* buffer;
+	if (ObjectPool* pool = typeinfo.GetPool())
+		buffer = pool->Allocate();
 	else
-		return nullptr;
+		buffer = GetObjectResource()->allocate(typeinfo->size, typeinfo->alignment);
+
+	details::Construct(ctor, typeinfo->size, buffer, argTypeIDs, args_buffer);
+
+	return { typeID, buffer };
 }
 
 bool ReflMngr::Delete(ConstObjectPtr obj) const {
@@ -1215,18 +1611,84 @@ bool ReflMngr::Delete(ConstObjectPtr obj) const {
 	if (!dtor_success)
 		return false;
 
-	const auto& typeinfo = typeinfos.at(obj.GetID());
+	details::TypeInfoView typeinfo{ obj.GetID() };
 
-	bool free_success;
-	if (typeinfo.alignment <= std::alignment_of_v<std::max_align_t>)
-		free_success = Free(const_cast<void*>(obj.GetPtr()));
+	if (ObjectPool* pool = typeinfo.GetPool())
+		pool->Deallocate(const_cast<void*>(obj.GetPtr()));
 	else
-		free_success = AlignedFree(const_cast<void*>(obj.GetPtr()));
+		GetObjectResource()->deallocate(const_cast<void*>(obj.GetPtr()), typeinfo->size, typeinfo->alignment);
+
+	return true;
+}
+
+void ReflMngr::SetObjectResource(std::pmr::memory_resource* rsrc) noexcept {
+	assert(rsrc);
+	object_resource.store(rsrc, std::memory_order_release);
+}
+
+bool ReflMngr::EnablePool(TypeID typeID, std::size_t blockCount) {
+	WriteGuard guard{ *this };
+
+	auto ttarget = typeinfos.find(typeID);
+	if (ttarget == typeinfos.end())
+		return false;
+	auto& typeinfo = ttarget->second;
+	if (typeinfo.pool)
+		return false;
+
+	typeinfo.pool = FindOrCreatePool(typeinfo.size, typeinfo.alignment, blockCount);
+	if (auto shared_class = details::FindSharedObjectClass(typeinfo.size, typeinfo.alignment))
+		typeinfo.shared_pool = FindOrCreatePool(shared_class->block_size(), alignof(std::max_align_t), blockCount);
+
+	guard.Modified();
+	return true;
+}
+
+ObjectPool* ReflMngr::FindOrCreatePool(std::size_t size, std::size_t alignment, std::size_t blockCount) {
+	// types of a size class share the pool
+	const std::size_t block_size = ObjectPool::SizeClass(size, alignment);
+	auto target = std::find_if(pools.begin(), pools.end(), [&](const std::unique_ptr<ObjectPool>& pool) {
+		return pool->BlockSize() == block_size && pool->BlockAlignment() >= alignment;
+	});
+	if (target != pools.end())
+		return target->get();
 
-	return free_success;
+	return pools.emplace_back(std::make_unique<ObjectPool>(size, alignment, blockCount)).get();
+}
+
+ObjectPool* ReflMngr::GetPool(TypeID typeID) const {
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
+		return nullptr;
+
+	return typeinfo.GetPool();
 }
 
 SharedObject ReflMngr::MakeShared(TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
+	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
+
+	{ // one allocation, the dtor is resolved once
+		details::TypeInfoView typeinfo{ typeID };
+		if (!typeinfo)
+			return nullptr;
+
+		auto shared_class = details::FindSharedObjectClass(typeinfo->size, typeinfo->alignment);
+		const bool trivial_dtor = typeinfo->traits.is_trivially_destructible;
+		const MethodInfo* dtor = trivial_dtor ? nullptr : details::FindDestructor(typeinfo);
+		if (shared_class && (trivial_dtor || dtor)) {
+			auto ctor = details::ResolveConstructor(typeinfo, typeID, argTypeIDs);
+			if (!ctor)
+				return nullptr;
+
+			ObjectPool* pool = typeinfo.GetSharedPool();
+			auto block = shared_class->allocate(pool ? pool : GetObjectResource());
+			details::Construct(ctor, typeinfo->size, block.buffer.get(), argTypeIDs, args_buffer);
+			if (dtor)
+				*block.dtor = &dtor->methodptr;
+			return { typeID, std::move(block.buffer) };
+		}
+	}
+
 	ObjectPtr obj = New(typeID, argTypeIDs, args_buffer);
 	return { obj, [typeID](void* ptr) {
 		bool success = ReflMngr::Instance().Delete({typeID, ptr});
@@ -1244,19 +1706,13 @@ ObjectPtr ReflMngr::StaticCast_DerivedToBase(ObjectPtr obj, TypeID typeID) const
 	if (obj.GetPtr() == nullptr)
 		return { typeID, nullptr };
 
-	auto target = typeinfos.find(obj.GetID());
-	if (target == typeinfos.end())
-		return nullptr;
-
-	const auto& typeinfo = target->second;
+	ReadGuard guard;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto ptr = StaticCast_DerivedToBase(ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, typeID);
-		if (ptr.GetID())
-			return ptr;
-	}
+	const CastPath& path = ResolveCastPath(obj.GetID(), typeID);
+	if (!path)
+		return nullptr;
 
-	return nullptr;
+	return { typeID, const_cast<void*>(path.DerivedToBase(obj.GetPtr())) };
 }
 
 ObjectPtr ReflMngr::StaticCast_BaseToDerived(ObjectPtr obj, TypeID typeID) const {
@@ -1269,19 +1725,20 @@ ObjectPtr ReflMngr::StaticCast_BaseToDerived(ObjectPtr obj, TypeID typeID) const
 	if (obj.GetPtr() == nullptr)
 		return { typeID, nullptr };
 
-	auto target = typeinfos.find(typeID);
-	if (target == typeinfos.end())
+	ReadGuard guard;
+
+	if (!IsDerivedFrom(typeID, obj.GetID()))
 		return nullptr;
 
-	const auto& typeinfo = target->second;
+	const CastPath& path = ResolveCastPath(typeID, obj.GetID());
+	if (!path)
+		return nullptr;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto ptr = StaticCast_BaseToDerived(obj, baseID);
-		if (ptr.GetID())
-			return { baseID, baseinfo.IsVirtual() ? nullptr : baseinfo.StaticCast_BaseToDerived(obj.GetPtr()) };
-	}
-	
-	return nullptr;
+	const void* derived = path.BaseToDerived(obj.GetPtr());
+	if (!derived)
+		return nullptr;
+
+	return { typeID, const_cast<void*>(derived) };
 }
 
 ObjectPtr ReflMngr::DynamicCast_BaseToDerived(ObjectPtr obj, TypeID typeID) const {
@@ -1294,19 +1751,20 @@ ObjectPtr ReflMngr::DynamicCast_BaseToDerived(ObjectPtr obj, TypeID typeID) cons
 	if (obj.GetPtr() == nullptr)
 		return { typeID, nullptr };
 
-	auto target = typeinfos.find(obj.GetID());
-	if (target == typeinfos.end())
+	ReadGuard guard;
+
+	if (!IsDerivedFrom(typeID, obj.GetID()))
 		return nullptr;
 
-	const auto& typeinfo = target->second;
+	const CastPath& path = ResolveCastPath(typeID, obj.GetID());
+	if (!path)
+		return nullptr;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto ptr = DynamicCast_BaseToDerived(ObjectPtr{ baseID, baseinfo.DynamicCast_BaseToDerived(obj.GetPtr()) }, typeID);
-		if (ptr.GetID())
-			return { baseID, baseinfo.IsPolymorphic() ? baseinfo.DynamicCast_BaseToDerived(obj.GetPtr()) : nullptr };
-	}
+	const void* ptr = path.DynamicBaseToDerived(obj.GetPtr());
+	if (!ptr)
+		return nullptr;
 
-	return nullptr;
+	return { typeID, const_cast<void*>(ptr) };
 }
 
 ObjectPtr ReflMngr::StaticCast(ObjectPtr obj, TypeID typeID) const {
@@ -1376,47 +1834,61 @@ ObjectPtr ReflMngr::RWVar(TypeID typeID, StrID fieldID) {
 		return RWVar(Dereference(typeID), fieldID);
 	}
 
-	auto ttarget = typeinfos.find(typeID);
-	if (ttarget == typeinfos.end())
-		return nullptr;
-
-	auto& typeinfo = ttarget->second;
+	ReadGuard guard;
+	if (const auto* ftypeinfo = GetFrozenTypeInfo(typeID)) {
+		auto field = details::FindFlatField(*ftypeinfo, fieldID, [](const FieldPtr& fieldptr) {
+			return fieldptr.IsUnowned();
+		});
+		if (!field)
+			return nullptr;
+		// the nodes of ReflMngr::typeinfos are mutable, for FieldPtr::RWVar
+		return const_cast<FieldInfo*>(field->fieldinfo)->fieldptr.RWVar();
+	}
 
-	auto ftarget = typeinfo.fieldinfos.find(fieldID);
-	if (ftarget != typeinfo.fieldinfos.end() && ftarget->second.fieldptr.IsUnowned())
-		return ftarget->second.fieldptr.RWVar();
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
+		return nullptr;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto bptr = RWVar(baseID, fieldID);
-		if (bptr.GetID())
-			return bptr;
-	}
+	auto fieldinfo = typeinfo.FindVarField(fieldID);
+	if (fieldinfo && fieldinfo->fieldptr.IsUnowned())
+		return fieldinfo->fieldptr.RWVar();
 
-	return nullptr;
+	ObjectPtr bptr;
+	typeinfo.AnyBase([&](TypeID baseID, const BaseInfo&) {
+		bptr = RWVar(baseID, fieldID);
+		return static_cast<bool>(bptr.GetID());
+	});
+	return bptr;
 }
 
 ConstObjectPtr ReflMngr::RVar(TypeID typeID, StrID fieldID) const {
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return RVar(Dereference(typeID), fieldID);
 
-	auto ttarget = typeinfos.find(typeID);
-	if (ttarget == typeinfos.end())
-		return nullptr;
-
-	auto& typeinfo = ttarget->second;
-
+	ReadGuard guard;
+	if (const auto* ftypeinfo = GetFrozenTypeInfo(typeID)) {
+		auto field = details::FindFlatField(*ftypeinfo, fieldID, [](const FieldPtr& fieldptr) {
+			return fieldptr.IsUnowned();
+		});
+		if (!field)
+			return nullptr;
+		return field->fieldinfo->fieldptr.RVar();
+	}
 
-	auto ftarget = typeinfo.fieldinfos.find(fieldID);
-	if (ftarget != typeinfo.fieldinfos.end() && ftarget->second.fieldptr.IsUnowned())
-		return ftarget->second.fieldptr.RVar();
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
+		return nullptr;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto bptr = RVar(baseID, fieldID);
-		if (bptr.GetID())
-			return bptr;
-	}
+	auto fieldinfo = typeinfo.FindField(fieldID);
+	if (fieldinfo && fieldinfo->fieldptr.IsUnowned())
+		return fieldinfo->fieldptr.RVar();
 
-	return nullptr;
+	ConstObjectPtr bptr;
+	typeinfo.AnyBase([&](TypeID baseID, const BaseInfo&) {
+		bptr = RVar(baseID, fieldID);
+		return static_cast<bool>(bptr.GetID());
+	});
+	return bptr;
 }
 
 ObjectPtr ReflMngr::RWVar(ObjectPtr obj, StrID fieldID) {
@@ -1427,47 +1899,60 @@ ObjectPtr ReflMngr::RWVar(ObjectPtr obj, StrID fieldID) {
 		return RWVar(Dereference(obj), fieldID);
 	}
 
-	auto ttarget = typeinfos.find(obj.GetID());
-	if (ttarget == typeinfos.end())
-		return nullptr;
-
-	auto& typeinfo = ttarget->second;
-
+	ReadGuard guard;
+	if (const auto* ftypeinfo = GetFrozenTypeInfo(obj.GetID())) {
+		auto field = details::FindFlatField(*ftypeinfo, fieldID, [](const FieldPtr& fieldptr) {
+			return fieldptr.IsVariable();
+		});
+		if (!field)
+			return nullptr;
+		// the nodes of ReflMngr::typeinfos are mutable, for FieldPtr::RWVar
+		return const_cast<FieldInfo*>(field->fieldinfo)->fieldptr.RWVar(
+			const_cast<void*>(details::StaticCast_DerivedToFieldType(*field, obj.GetPtr())));
+	}
 
-	auto ftarget = typeinfo.fieldinfos.find(fieldID);
-	if (ftarget != typeinfo.fieldinfos.end() && ftarget->second.fieldptr.IsVariable())
-		return ftarget->second.fieldptr.RWVar(obj.GetPtr());
+	details::TypeInfoView typeinfo{ obj.GetID() };
+	if (!typeinfo)
+		return nullptr;
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto bptr = RWVar(ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, fieldID);
-		if (bptr.GetID())
-			return bptr;
-	}
+	auto fieldinfo = typeinfo.FindVarField(fieldID);
+	if (fieldinfo && fieldinfo->fieldptr.IsVariable())
+		return fieldinfo->fieldptr.RWVar(obj.GetPtr());
 
-	return nullptr;
+	ObjectPtr bptr;
+	typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
+		bptr = RWVar(ObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, fieldID);
+		return static_cast<bool>(bptr.GetID());
+	});
+	return bptr;
 }
 
 ConstObjectPtr ReflMngr::RVar(ConstObjectPtr obj, StrID fieldID) const {
 	if (GetDereferenceProperty(obj.GetID()) != DereferenceProperty::NotReference)
-		return RVar(DereferenceAsConst(obj), fieldID);
-
-	auto ttarget = typeinfos.find(obj.GetID());
-	if (ttarget == typeinfos.end())
-		return nullptr;
-
-	const auto& typeinfo = ttarget->second;
-
-	auto ftarget = typeinfo.fieldinfos.find(fieldID);
-	if (ftarget != typeinfo.fieldinfos.end())
-		return ftarget->second.fieldptr.RVar(obj.GetPtr());
+		return RVar(DereferenceAsConst(obj), fieldID);
 
-	for (const auto& [baseID, baseinfo] : typeinfo.baseinfos) {
-		auto bptr = RVar(ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, fieldID);
-		if (bptr.GetID())
-			return bptr;
+	ReadGuard guard;
+	if (const auto* ftypeinfo = GetFrozenTypeInfo(obj.GetID())) {
+		const auto* fields = ftypeinfo->flat_fieldinfos.Find(fieldID);
+		if (!fields)
+			return nullptr;
+		const FlatField& field = fields->front();
+		return field.fieldinfo->fieldptr.RVar(details::StaticCast_DerivedToFieldType(field, obj.GetPtr()));
 	}
 
-	return nullptr;
+	details::TypeInfoView typeinfo{ obj.GetID() };
+	if (!typeinfo)
+		return nullptr;
+
+	if (auto fieldinfo = typeinfo.FindField(fieldID))
+		return fieldinfo->fieldptr.RVar(obj.GetPtr());
+
+	ConstObjectPtr bptr;
+	typeinfo.AnyBase([&](TypeID baseID, const BaseInfo& baseinfo) {
+		bptr = RVar(ConstObjectPtr{ baseID, baseinfo.StaticCast_DerivedToBase(obj.GetPtr()) }, fieldID);
+		return static_cast<bool>(bptr.GetID());
+	});
+	return bptr;
 }
 
 ObjectPtr ReflMngr::RWVar(ObjectPtr obj, TypeID baseID, StrID fieldID) {
@@ -1484,6 +1969,29 @@ ConstObjectPtr ReflMngr::RVar(ConstObjectPtr obj, TypeID baseID, StrID fieldID)
 	return RVar(base, fieldID);
 }
 
+FieldHandle ReflMngr::ResolveField(TypeID typeID, StrID fieldID) const {
+	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
+		return ResolveField(Dereference(typeID), fieldID);
+
+	ReadGuard guard;
+	if (const auto* ftypeinfo = GetFrozenTypeInfo(typeID)) {
+		const auto* fields = ftypeinfo->flat_fieldinfos.Find(fieldID);
+		if (!fields)
+			return {};
+		const FlatField& field = fields->front();
+		return { typeID, *field.fieldinfo, field.offset, std::vector<const BaseInfo*>(field.path.begin(), field.path.end()) };
+	}
+
+	std::vector<const BaseInfo*> path;
+	const FieldInfo* fieldinfo = details::FindField(typeID, fieldID, path);
+	if (!fieldinfo)
+		return {};
+
+	// bases with an offset fold into a constant one
+	CastPath cast = CastPath::FromPath(std::move(path));
+	return { typeID, *fieldinfo, cast.offset, std::move(cast.unfolded_path) };
+}
+
 bool ReflMngr::IsCompatible(std::span<const TypeID> params, std::span<const TypeID> argTypeIDs) const {
 	if (params.size() != argTypeIDs.size())
 		return false;
@@ -1492,68 +2000,50 @@ bool ReflMngr::IsCompatible(std::span<const TypeID> params, std::span<const Type
 		if (params[i] == argTypeIDs[i])
 			continue;
 
-		auto lhs = tregistry.Nameof(params[i]);
-#ifndef NDEBUG
-		// because rhs(arg)'s ID maybe have no name in the registry
-		// so we use type_name_add_*_hash(...) to avoid it
-		auto rhs = tregistry.Nameof(argTypeIDs[i]);
-#endif // !NDEBUG
-		const std::size_t rhs_hash = argTypeIDs[i].GetValue();
-
-		assert(!type_name_is_const(lhs) && !type_name_is_volatile(lhs));
-		if (type_name_is_lvalue_reference(lhs)) { // &{T} | &{const{T}}
-			auto unref_lhs = type_name_remove_reference(lhs); // T | const{T}
-			if (type_name_is_const(unref_lhs)) { // &{const{T}}
-				if (type_name_add_rvalue_reference_hash(unref_lhs) == rhs_hash)
-					continue; // &{const{T}} <- &&{const{T}}
+		// rhs(arg)'s ID maybe have no shape in the registry, so we only compare with lhs's shape
+		const auto* lhs = tregistry.GetShape(params[i]);
+		if (!lhs)
+			return false;
 
-				auto raw_lhs = type_name_remove_const(unref_lhs); // T
-				TypeID raw_lhs_ID{ raw_lhs };
+		const TypeID rhs = argTypeIDs[i];
+
+		if (lhs->IsLValueReference()) { // &{T} | &{const{T}}
+			if (lhs->is_const) { // &{const{T}}
+				if (lhs->crref == rhs)
+					continue; // &{const{T}} <- &&{const{T}}
 
-				if (raw_lhs_ID.GetValue() == rhs_hash
-					|| type_name_add_lvalue_reference_hash(raw_lhs) == rhs_hash
-					|| type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash)
+				if (lhs->raw == rhs || lhs->lref == rhs || lhs->rref == rhs)
 					continue; // &{const{T}} <- T | &{T} | &&{T}
 
-				if (IsNonArgCopyConstructible(raw_lhs_ID, std::span<const TypeID>{&argTypeIDs[i], 1}))
+				if (IsNonArgCopyConstructible(lhs->raw, std::span<const TypeID>{&argTypeIDs[i], 1}))
 					continue; // &{const{T}} <- T{arg}
 			}
 		}
-		else if (type_name_is_rvalue_reference(lhs)) { // &&{T} | &&{const{T}}
-			auto unref_lhs = type_name_remove_reference(lhs); // T | const{T}
-			assert(!type_name_is_volatile(unref_lhs));
-
-			if (type_name_is_const(unref_lhs)) { // &&{const{T}}
-				auto raw_lhs = type_name_remove_const(unref_lhs); // T
-				TypeID raw_lhs_ID{ raw_lhs };
-
-				if (raw_lhs_ID.GetValue() == rhs_hash)
+		else if (lhs->IsRValueReference()) { // &&{T} | &&{const{T}}
+			if (lhs->is_const) { // &&{const{T}}
+				if (lhs->raw == rhs)
 					continue; // &&{const{T}} <- T
 
-				if (type_name_add_rvalue_reference_hash(raw_lhs) == rhs_hash) // &&{const{T}}
+				if (lhs->rref == rhs)
 					continue; // &&{const{T}} <- &&{T}
 
-				if (IsNonArgCopyConstructible(raw_lhs_ID, std::span<const TypeID>{&argTypeIDs[i], 1}))
+				if (IsNonArgCopyConstructible(lhs->raw, std::span<const TypeID>{&argTypeIDs[i], 1}))
 					continue; // &&{const{T}} <- T{arg}
 			}
 			else {
-				TypeID unref_lhs_ID{ unref_lhs };
-
-				if (unref_lhs_ID.GetValue() == rhs_hash)
+				if (lhs->raw == rhs)
 					continue; // &&{T} <- T
 
-				if (IsNonArgCopyConstructible(unref_lhs_ID, std::span<const TypeID>{&argTypeIDs[i], 1}))
+				if (IsNonArgCopyConstructible(lhs->raw, std::span<const TypeID>{&argTypeIDs[i], 1}))
 					continue; // &&{T} <- T{arg}
 			}
 		}
 		else { // T
-			if (type_name_add_rvalue_reference_hash(lhs) == rhs_hash)
+			if (lhs->rref == rhs)
 				continue; // T <- &&{T}
 
-			if (type_name_is_pointer(lhs) || IsCopyConstructible(lhs)) {
-				if (type_name_add_lvalue_reference_hash(lhs) == rhs_hash
-					|| type_name_add_const_lvalue_reference_hash(lhs) == rhs_hash
-					|| type_name_add_const_rvalue_reference_hash(lhs) == rhs_hash)
+			if (lhs->is_pointer || IsCopyConstructible(params[i])) {
+				if (lhs->lref == rhs || lhs->clref == rhs || lhs->crref == rhs)
 					continue; // T <- T{arg} [copy]
 			}
 
@@ -1575,10 +2065,12 @@ InvocableResult ReflMngr::IsStaticInvocable(
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return IsStaticInvocable(Dereference(typeID), methodID, argTypeIDs);
 
-	if (auto priority_rst = details::IsStaticInvocable(true, typeID, methodID, argTypeIDs))
-		return priority_rst;
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Static, typeID, methodID, argTypeIDs);
+	if (!resolution)
+		return {};
 
-	return details::IsStaticInvocable(false, typeID, methodID, argTypeIDs);
+	return { true, resolution.methodinfo->methodptr.GetResultDesc() };
 }
 
 InvocableResult ReflMngr::IsConstInvocable(
@@ -1589,10 +2081,12 @@ InvocableResult ReflMngr::IsConstInvocable(
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return IsConstInvocable(Dereference(typeID), methodID, argTypeIDs);
 
-	if (auto priority_rst = details::IsConstInvocable(true, typeID, methodID, argTypeIDs))
-		return priority_rst;
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Const, typeID, methodID, argTypeIDs);
+	if (!resolution)
+		return {};
 
-	return details::IsConstInvocable(false, typeID, methodID, argTypeIDs);
+	return { true, resolution.methodinfo->methodptr.GetResultDesc() };
 }
 
 InvocableResult ReflMngr::IsInvocable(
@@ -1603,10 +2097,12 @@ InvocableResult ReflMngr::IsInvocable(
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return IsInvocable(Dereference(typeID), methodID, argTypeIDs);
 
-	if (auto priority_rst = details::IsInvocable(true, typeID, methodID, argTypeIDs))
-		return priority_rst;
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Variable, typeID, methodID, argTypeIDs);
+	if (!resolution)
+		return {};
 
-	return details::IsInvocable(false, typeID, methodID, argTypeIDs);
+	return { true, resolution.methodinfo->methodptr.GetResultDesc() };
 }
 
 InvokeResult ReflMngr::Invoke(
@@ -1619,10 +2115,9 @@ InvokeResult ReflMngr::Invoke(
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return Invoke(Dereference(typeID), methodID, result_buffer, argTypeIDs, args_buffer);
 
-	if(auto priority_rst = details::Invoke(true, &temporary_resource, typeID, methodID, result_buffer, argTypeIDs, args_buffer))
-		return priority_rst;
-
-	return details::Invoke(false, &temporary_resource, typeID, methodID, result_buffer, argTypeIDs, args_buffer);
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Static, typeID, methodID, argTypeIDs);
+	return details::Invoke(resolution, &ScratchArena::ArgumentArena(), nullptr, result_buffer, args_buffer);
 }
 
 InvokeResult ReflMngr::Invoke(
@@ -1643,10 +2138,9 @@ InvokeResult ReflMngr::Invoke(
 		break;
 	}
 
-	if (auto priority_rst = details::Invoke(true, &temporary_resource, obj, methodID, result_buffer, argTypeIDs, args_buffer))
-		return priority_rst;
-
-	return details::Invoke(false, &temporary_resource, obj, methodID, result_buffer, argTypeIDs, args_buffer);
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Const, obj.GetID(), methodID, argTypeIDs);
+	return details::Invoke(resolution, &ScratchArena::ArgumentArena(), obj.GetPtr(), result_buffer, args_buffer);
 }
 
 InvokeResult ReflMngr::Invoke(
@@ -1667,10 +2161,76 @@ InvokeResult ReflMngr::Invoke(
 		break;
 	}
 
-	if (auto priority_rst = details::Invoke(true, &temporary_resource, obj, methodID, result_buffer, argTypeIDs, args_buffer))
-		return priority_rst;
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Variable, obj.GetID(), methodID, argTypeIDs);
+	return details::Invoke(resolution, &ScratchArena::ArgumentArena(), obj.GetPtr(), result_buffer, args_buffer);
+}
+
+std::size_t ReflMngr::InvokeBatch(
+	std::span<const ObjectPtr> objs,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	std::span<const ArgsBuffer> args_buffers,
+	std::span<void* const> result_buffers,
+	std::span<InvokeResult> results) const
+{
+	assert(args_buffers.size() <= 1 || args_buffers.size() == objs.size());
+	assert(result_buffers.empty() || result_buffers.size() == objs.size());
+	assert(results.empty() || results.size() == objs.size());
+	assert(result_buffers.empty() || !results.empty());
+
+	ReadGuard guard;
+
+	auto& args_rsrc = ScratchArena::ArgumentArena();
+
+	// a batch has a few types, a linear search over them
+	std::vector<details::BatchTarget> targets;
+	const details::BatchTarget* target = nullptr;
+
+	std::size_t num_invoked = 0;
+	for (std::size_t i = 0; i < objs.size(); i++) {
+		const ObjectPtr& obj = objs[i];
+		assert(GetDereferenceProperty(obj.GetID()) == DereferenceProperty::NotReference);
+
+		if (!target || target->GetTypeID() != obj.GetID()) {
+			auto iter = std::find_if(targets.begin(), targets.end(), [&](const details::BatchTarget& t) {
+				return t.GetTypeID() == obj.GetID();
+			});
+			if (iter == targets.end()) {
+				targets.emplace_back(obj.GetID(), ResolveOverload(MethodSearchMode::Variable, obj.GetID(), methodID, argTypeIDs));
+				iter = std::prev(targets.end());
+			}
+			target = &*iter;
+		}
+
+		if (!*target) {
+			if (!results.empty())
+				results[i] = {};
+			continue;
+		}
+
+		ArgsBuffer args_buffer = args_buffers.empty() ? nullptr : args_buffers[args_buffers.size() == 1 ? 0 : i];
+		void* result_buffer = result_buffers.empty() ? nullptr : result_buffers[i];
+
+		Destructor dtor = target->Invoke(&args_rsrc, obj.GetPtr(), result_buffer, args_buffer);
+		if (!results.empty())
+			results[i] = { true, target->GetResultTypeID(), std::move(dtor) };
+
+		++num_invoked;
+	}
+
+	return num_invoked;
+}
+
+bool ReflMngr::Apply(StrID op, TypeID typeID, std::size_t count, void* out, const void* lhs, const void* rhs) const {
+	ArrayKernel kernel = FindArrayKernel(op, typeID);
+	if (!kernel)
+		return false;
+
+	if (count > 0)
+		kernel(out, lhs, rhs, count);
 
-	return details::Invoke(false, &temporary_resource, obj, methodID, result_buffer, argTypeIDs, args_buffer);
+	return true;
 }
 
 SharedObject ReflMngr::MInvoke(
@@ -1684,10 +2244,9 @@ SharedObject ReflMngr::MInvoke(
 	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
 		return MInvoke(Dereference(typeID), methodID, argTypeIDs, args_buffer, rst_rsrc);
 
-	if (auto priority_rst = details::MInvoke(true, &temporary_resource, typeID, methodID, argTypeIDs, args_buffer, rst_rsrc))
-		return priority_rst;
-
-	return details::MInvoke(false, &temporary_resource, typeID, methodID, argTypeIDs, args_buffer, rst_rsrc);
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Static, typeID, methodID, argTypeIDs);
+	return details::MInvoke(resolution, &ScratchArena::ArgumentArena(), nullptr, args_buffer, rst_rsrc);
 }
 
 SharedObject ReflMngr::MInvoke(
@@ -1709,10 +2268,9 @@ SharedObject ReflMngr::MInvoke(
 		break;
 	}
 
-	if (auto priority_rst = details::MInvoke(true, &temporary_resource, obj, methodID, argTypeIDs, args_buffer, rst_rsrc))
-		return priority_rst;
-
-	return details::MInvoke(false, &temporary_resource, obj, methodID, argTypeIDs, args_buffer, rst_rsrc);
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Const, obj.GetID(), methodID, argTypeIDs);
+	return details::MInvoke(resolution, &ScratchArena::ArgumentArena(), obj.GetPtr(), args_buffer, rst_rsrc);
 }
 
 SharedObject ReflMngr::MInvoke(
@@ -1734,32 +2292,32 @@ SharedObject ReflMngr::MInvoke(
 		break;
 	}
 
-	if (auto priority_rst = details::MInvoke(true, &temporary_resource, obj, methodID, argTypeIDs, args_buffer, rst_rsrc))
-		return priority_rst;
-
-	return details::MInvoke(false, &temporary_resource, obj, methodID, argTypeIDs, args_buffer, rst_rsrc);
+	ReadGuard guard;
+	const auto& resolution = ResolveOverload(MethodSearchMode::Variable, obj.GetID(), methodID, argTypeIDs);
+	return details::MInvoke(resolution, &ScratchArena::ArgumentArena(), obj.GetPtr(), args_buffer, rst_rsrc);
 }
 
 ObjectPtr ReflMngr::MNew(TypeID typeID, std::pmr::memory_resource* rsrc, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
 	assert(rsrc);
+	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
 
-	if (!IsConstructible(typeID, argTypeIDs))
+	// resolve the ctor once, then allocate
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
 		return nullptr;
 
-	const auto& typeinfo = typeinfos.at(typeID);
+	auto ctor = details::ResolveConstructor(typeinfo, typeID, argTypeIDs);
+	if (!ctor)
+		return nullptr;
 
-	void* buffer = rsrc->allocate(typeinfo.size, typeinfo.alignment);
+	void* buffer = rsrc->allocate(typeinfo->size, typeinfo->alignment);
 
 	if (!buffer)
 		return nullptr;
 
-	ObjectPtr obj{ typeID, buffer };
-	bool success = Construct(obj, argTypeIDs, args_buffer);
+	details::Construct(ctor, typeinfo->size, buffer, argTypeIDs, args_buffer);
 
-	if (success)
-		return obj;
-	else
-		return nullptr;
+	return { typeID, buffer };
 }
 
 bool ReflMngr::MDelete(ConstObjectPtr obj, std::pmr::memory_resource* rsrc) const {
@@ -1769,7 +2327,7 @@ bool ReflMngr::MDelete(ConstObjectPtr obj, std::pmr::memory_resource* rsrc) cons
 	if (!dtor_success)
 		return false;
 
-	const auto& typeinfo = typeinfos.at(obj.GetID());
+	const auto& typeinfo = *details::TypeInfoView{ obj.GetID() };
 
 	rsrc->deallocate(ConstCast(obj).GetPtr(), typeinfo.size, typeinfo.alignment);
 
@@ -1779,64 +2337,55 @@ bool ReflMngr::MDelete(ConstObjectPtr obj, std::pmr::memory_resource* rsrc) cons
 bool ReflMngr::IsNonArgCopyConstructible(TypeID typeID, std::span<const TypeID> argTypeIDs) const {
 	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
 
-	auto target = typeinfos.find(typeID);
-	if (target == typeinfos.end())
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
 		return false;
-	const auto& typeinfo = target->second;
-	constexpr auto ctorID = StrIDRegistry::MetaID::ctor;
-	auto mtarget = typeinfo.methodinfos.find(ctorID);
-	size_t num = typeinfo.methodinfos.count(ctorID);
-	for (size_t i = 0; i < num; ++i, ++mtarget) {
-		if (details::IsNonArgCopyConstructCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs))
-			return true;
-	}
-	return false;
+
+	return typeinfo.FindMethod(StrIDRegistry::MetaID::ctor, [&](const MethodPtr& methodptr) {
+		return details::IsNonArgCopyConstructCompatible(methodptr.GetParamList(), argTypeIDs);
+	}) != nullptr;
 }
 
 bool ReflMngr::IsConstructible(TypeID typeID, std::span<const TypeID> argTypeIDs) const {
 	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
 
-	auto target = typeinfos.find(typeID);
-	if (target == typeinfos.end())
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
 		return false;
-	const auto& typeinfo = target->second;
-	constexpr auto ctorID = StrIDRegistry::MetaID::ctor;
-	auto mtarget = typeinfo.methodinfos.find(ctorID);
-	size_t num = typeinfo.methodinfos.count(ctorID);
-	for (size_t i = 0; i < num; ++i, ++mtarget) {
-		if (IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs))
-			return true;
-	}
-	return false;
+
+	return typeinfo.FindMethod(StrIDRegistry::MetaID::ctor, [&](const MethodPtr& methodptr) {
+		return IsCompatible(methodptr.GetParamList(), argTypeIDs);
+	}) != nullptr;
 }
 
 bool ReflMngr::IsCopyConstructible(TypeID typeID) const {
-	std::array argTypeIDs = { TypeID{ type_name_add_const_lvalue_reference_hash(tregistry.Nameof(typeID)) } };
+	const auto* shape = tregistry.GetShape(typeID);
+	if (!shape)
+		return false;
+
+	std::array argTypeIDs = { shape->clref };
 	return IsNonArgCopyConstructible(typeID, argTypeIDs);
 }
 
 bool ReflMngr::IsMoveConstructible(TypeID typeID) const {
-	std::array argTypeIDs = { TypeID{ type_name_add_rvalue_reference_hash(tregistry.Nameof(typeID)) } };
+	const auto* shape = tregistry.GetShape(typeID);
+	if (!shape)
+		return false;
+
+	std::array argTypeIDs = { shape->rref };
 	return IsNonArgCopyConstructible(typeID, argTypeIDs);
 }
 
 bool ReflMngr::IsDestructible(TypeID typeID) const {
 	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
 
-	auto target = typeinfos.find(typeID);
-	if (target == typeinfos.end())
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo)
 		return false;
-	const auto& typeinfo = target->second;
-	constexpr auto dtorID = StrIDRegistry::MetaID::dtor;
-
-	auto mtarget = typeinfo.methodinfos.find(dtorID);
-	size_t num = typeinfo.methodinfos.count(dtorID);
-	for (size_t i = 0; i < num; ++i, ++mtarget) {
-		if (!mtarget->second.methodptr.IsMemberVariable()
-			&& IsCompatible(mtarget->second.methodptr.GetParamList(), {}))
-			return true;
-	}
-	return false;
+
+	return typeinfo.FindMethod(StrIDRegistry::MetaID::dtor, [&](const MethodPtr& methodptr) {
+		return !methodptr.IsMemberVariable() && IsCompatible(methodptr.GetParamList(), {});
+	}) != nullptr;
 }
 
 bool ReflMngr::Construct(ObjectPtr obj, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) const {
@@ -1845,23 +2394,16 @@ bool ReflMngr::Construct(ObjectPtr obj, std::span<const TypeID> argTypeIDs, Args
 	if (!obj.Valid())
 		return false;
 
-	auto target = typeinfos.find(obj.GetID());
-	if (target == typeinfos.end())
+	details::TypeInfoView typeinfo{ obj.GetID() };
+	if (!typeinfo)
 		return false;
-	const auto& typeinfo = target->second;
-	constexpr auto ctorID = StrIDRegistry::MetaID::ctor;
-	auto mtarget = typeinfo.methodinfos.find(ctorID);
-	size_t num = typeinfo.methodinfos.count(ctorID);
-	for (size_t i = 0; i < num; ++i, ++mtarget) {
-		if (mtarget->second.methodptr.IsMemberVariable()
-			&& IsCompatible(mtarget->second.methodptr.GetParamList(), argTypeIDs))
-		{
-			details::ConstructedArgumentsGuard guard{ &temporary_resource, mtarget->second.methodptr.GetParamList(), argTypeIDs, args_buffer };
-			mtarget->second.methodptr.Invoke(obj.GetPtr(), nullptr, guard.GetArgsBuffer());
-			return true;
-		}
-	}
-	return false;
+
+	auto ctor = details::ResolveConstructor(typeinfo, obj.GetID(), argTypeIDs);
+	if (!ctor)
+		return false;
+
+	details::Construct(ctor, typeinfo->size, obj.GetPtr(), argTypeIDs, args_buffer);
+	return true;
 }
 
 bool ReflMngr::Destruct(ConstObjectPtr obj) const {
@@ -1870,22 +2412,30 @@ bool ReflMngr::Destruct(ConstObjectPtr obj) const {
 	if (!obj.Valid())
 		return false;
 
-	auto target = typeinfos.find(obj.GetID());
-	if (target == typeinfos.end())
+	details::TypeInfoView typeinfo{ obj.GetID() };
+	if (!typeinfo)
 		return false;
-	const auto& typeinfo = target->second;
-	constexpr auto dtorID = StrIDRegistry::MetaID::dtor;
-	auto mtarget = typeinfo.methodinfos.find(dtorID);
-	size_t num = typeinfo.methodinfos.count(dtorID);
-	for (size_t i = 0; i < num; ++i, ++mtarget) {
-		if (mtarget->second.methodptr.IsMemberConst()
-			&& IsCompatible(mtarget->second.methodptr.GetParamList(), {}))
-		{
-			mtarget->second.methodptr.Invoke(obj.GetPtr(), nullptr, {});
-			return true;
-		}
-	}
-	return false;
+
+	if (typeinfo->traits.is_trivially_destructible)
+		return true;
+
+	auto methodinfo = details::FindDestructor(typeinfo);
+	if (!methodinfo)
+		return false;
+
+	methodinfo->methodptr.Invoke(obj.GetPtr(), nullptr, {});
+	return true;
+}
+
+const MethodPtr* ReflMngr::GetDestructor(TypeID typeID) const {
+	assert(GetDereferenceProperty(typeID) == DereferenceProperty::NotReference);
+
+	details::TypeInfoView typeinfo{ typeID };
+	if (!typeinfo || typeinfo->traits.is_trivially_destructible)
+		return nullptr;
+
+	auto methodinfo = details::FindDestructor(typeinfo);
+	return methodinfo ? &methodinfo->methodptr : nullptr;
 }
 
 void ReflMngr::ForEachTypeID(TypeID typeID, const std::function<bool(TypeID)>& func) const {
@@ -1903,11 +2453,9 @@ void ReflMngr::ForEachField(
 	const std::function<bool(TypeRef, FieldRef)>& func) const
 {
 	ForEachType(typeID, [&func](TypeRef type) {
-		for (auto& [fieldID, fieldInfo] : type.info.fieldinfos) {
-			if (!func(type, { fieldID, fieldInfo }))
-				return false;
-		}
-		return true;
+		return !details::TypeInfoView{ type.ID }.AnyField([&](StrID fieldID, FieldInfo& fieldinfo) {
+			return !func(type, { fieldID, fieldinfo });
+		});
 	});
 }
 
@@ -1916,11 +2464,9 @@ void ReflMngr::ForEachMethod(
 	const std::function<bool(TypeRef, MethodRef)>& func) const
 {
 	ForEachType(typeID, [&func](TypeRef type) {
-		for (auto& [methodID, methodInfo] : type.info.methodinfos) {
-			if (!func(type, { methodID, methodInfo }))
-				return false;
-		}
-		return true;
+		return !details::TypeInfoView{ type.ID }.AnyMethod([&](StrID methodID, MethodInfo& methodinfo) {
+			return !func(type, { methodID, methodinfo });
+		});
 	});
 }
 
@@ -2290,64 +2836,279 @@ ConstObjectPtr ReflMngr::FindROwnedVar(ConstObjectPtr obj, const std::function<b
 	return rst;
 }
 
+Executor& ReflMngr::GetExecutor() const {
+	Executor* e = executor.load(std::memory_order_acquire);
+	return e ? *e : ThreadPool::Default();
+}
+
+bool ReflMngr::CaptureCall(
+	details::CapturedCall& call,
+	MethodSearchMode mode,
+	TypeID typeID,
+	const void* obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	assert(result_rsrc);
+
+	call.mode = mode;
+	call.obj = obj;
+	call.result_rsrc = result_rsrc;
+
+	ReadGuard guard;
+
+	const auto& resolution = ResolveOverload(mode, typeID, methodID, argTypeIDs);
+	if (!resolution)
+		return false;
+
+	// the call's arguments, the copies are passed as &&{T}
+	std::span<const TypeID> params = resolution.methodinfo->methodptr.GetParamList();
+	std::vector<TypeID> call_argTypeIDs{ argTypeIDs.begin(), argTypeIDs.end() };
+	call.args.resize(argTypeIDs.size());
+	call.pointers.resize(argTypeIDs.size());
+	for (std::size_t i = 0; i < argTypeIDs.size(); i++) {
+		call.args[i] = args_buffer[i];
+
+		const auto* shape = tregistry.GetShape(params[i]);
+		assert(shape);
+		if (shape->IsLValueReference() && !shape->is_const)
+			continue; // &{T} binds the caller's object
+
+		if (shape->is_pointer && !shape->IsReference()) {
+			call.pointers[i] = *static_cast<void* const*>(args_buffer[i]);
+			call.args[i] = &call.pointers[i];
+			call_argTypeIDs[i] = params[i];
+			continue;
+		}
+
+		ObjectPtr copy = New(shape->raw, std::span<const TypeID>{ &argTypeIDs[i], 1 }, &args_buffer[i]);
+		if (!copy)
+			return false; // not copyable, the caller's object may not outlive the call
+
+		call.copies.push_back(copy);
+		call.args[i] = copy.GetPtr();
+		call_argTypeIDs[i] = shape->rref;
+	}
+
+	// same overload, the plan converts from the call's arguments
+	MethodResolution call_resolution;
+	call_resolution.methodinfo = resolution.methodinfo;
+	call_resolution.path = resolution.path;
+	call_resolution.plan = details::CompileArgumentConversionPlan(params, call_argTypeIDs);
+	call.handle = MethodHandle{ typeID, call_resolution };
+
+	return true;
+}
+
+std::future<SharedObject> ReflMngr::ScheduleInvoke(
+	MethodSearchMode mode,
+	TypeID typeID,
+	const void* obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto call = std::make_shared<details::AsyncCall>();
+	std::future<SharedObject> future = call->promise.get_future();
+
+	if (!CaptureCall(*call, mode, typeID, obj, methodID, argTypeIDs, args_buffer, result_rsrc)) {
+		call->promise.set_value({});
+		return future;
+	}
+
+	GetExecutor().Execute([call] { call->Run(); });
+
+	return future;
+}
+
+std::future<SharedObject> ReflMngr::MInvokeAsync(
+	TypeID typeID,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
+		return MInvokeAsync(Dereference(typeID), methodID, argTypeIDs, args_buffer, result_rsrc);
+
+	return ScheduleInvoke(MethodSearchMode::Static, typeID, nullptr, methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+std::future<SharedObject> ReflMngr::MInvokeAsync(
+	ConstObjectPtr obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto deref_prop = GetDereferenceProperty(obj.GetID());
+	switch (deref_prop)
+	{
+	case Ubpa::UDRefl::DereferenceProperty::Variable:
+		return MInvokeAsync(Dereference(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	case Ubpa::UDRefl::DereferenceProperty::Const:
+		return MInvokeAsync(DereferenceAsConst(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	default:
+		break;
+	}
+
+	return ScheduleInvoke(MethodSearchMode::Const, obj.GetID(), obj.GetPtr(), methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+std::future<SharedObject> ReflMngr::MInvokeAsync(
+	ObjectPtr obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto deref_prop = GetDereferenceProperty(obj.GetID());
+	switch (deref_prop)
+	{
+	case Ubpa::UDRefl::DereferenceProperty::Variable:
+		return MInvokeAsync(Dereference(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	case Ubpa::UDRefl::DereferenceProperty::Const:
+		return MInvokeAsync(DereferenceAsConst(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	default:
+		break;
+	}
+
+	return ScheduleInvoke(MethodSearchMode::Variable, obj.GetID(), obj.GetPtr(), methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+Task<SharedObject> ReflMngr::ScheduleInvokeCo(
+	MethodSearchMode mode,
+	TypeID typeID,
+	const void* obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto call = std::make_shared<details::CapturedCall>();
+	if (!CaptureCall(*call, mode, typeID, obj, methodID, argTypeIDs, args_buffer, result_rsrc))
+		call.reset();
+
+	return details::AwaitCall(std::move(call));
+}
+
+Task<SharedObject> ReflMngr::MInvokeCo(
+	TypeID typeID,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	if (GetDereferenceProperty(typeID) != DereferenceProperty::NotReference)
+		return MInvokeCo(Dereference(typeID), methodID, argTypeIDs, args_buffer, result_rsrc);
+
+	return ScheduleInvokeCo(MethodSearchMode::Static, typeID, nullptr, methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+Task<SharedObject> ReflMngr::MInvokeCo(
+	ConstObjectPtr obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto deref_prop = GetDereferenceProperty(obj.GetID());
+	switch (deref_prop)
+	{
+	case Ubpa::UDRefl::DereferenceProperty::Variable:
+		return MInvokeCo(Dereference(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	case Ubpa::UDRefl::DereferenceProperty::Const:
+		return MInvokeCo(DereferenceAsConst(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	default:
+		break;
+	}
+
+	return ScheduleInvokeCo(MethodSearchMode::Const, obj.GetID(), obj.GetPtr(), methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+Task<SharedObject> ReflMngr::MInvokeCo(
+	ObjectPtr obj,
+	StrID methodID,
+	std::span<const TypeID> argTypeIDs,
+	ArgsBuffer args_buffer,
+	std::pmr::memory_resource* result_rsrc) const
+{
+	auto deref_prop = GetDereferenceProperty(obj.GetID());
+	switch (deref_prop)
+	{
+	case Ubpa::UDRefl::DereferenceProperty::Variable:
+		return MInvokeCo(Dereference(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	case Ubpa::UDRefl::DereferenceProperty::Const:
+		return MInvokeCo(DereferenceAsConst(obj), methodID, argTypeIDs, args_buffer, result_rsrc);
+	default:
+		break;
+	}
+
+	return ScheduleInvokeCo(MethodSearchMode::Variable, obj.GetID(), obj.GetPtr(), methodID, argTypeIDs, args_buffer, result_rsrc);
+}
+
+ThreadPool& ReflMngr::GetThreadPool() const {
+	ThreadPool* pool = thread_pool.load(std::memory_order_acquire);
+	return pool ? *pool : ThreadPool::Default();
+}
+
+void ReflMngr::ParallelForEach(
+	std::span<const ObjectPtr> objs,
+	const std::function<void(std::size_t, ObjectPtr)>& func,
+	std::size_t grain) const
+{
+	GetThreadPool().ParallelFor(objs.size(), grain, [&](std::size_t worker, std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+			func(worker, objs[i]);
+	});
+}
+
 DereferenceProperty ReflMngr::GetDereferenceProperty(TypeID ID) const {
-	auto name = tregistry.Nameof(ID);
+	const auto* shape = tregistry.GetShape(ID);
 
-	if (!type_name_is_reference(name))
+	if (!shape || !shape->IsReference())
 		return DereferenceProperty::NotReference;
 
-	auto unref_name = type_name_remove_reference(name);
-
-	return type_name_is_const(unref_name) ? DereferenceProperty::Const : DereferenceProperty::Variable;
+	return shape->is_const ? DereferenceProperty::Const : DereferenceProperty::Variable;
 }
 
 TypeID ReflMngr::Dereference(TypeID ID) const {
-	auto name = tregistry.Nameof(ID);
+	const auto* shape = tregistry.GetShape(ID);
 
-	if (!type_name_is_reference(name))
+	if (!shape || !shape->IsReference())
 		return ID;
 
-	std::string_view ele_name = type_name_remove_reference(name);
-
-	auto rst_name = type_name_remove_cv(ele_name);
-
-	return rst_name;
+	return shape->raw;
 }
 
 ObjectPtr ReflMngr::Dereference(ConstObjectPtr ref_obj) const {
 	if (!ref_obj.GetPtr())
 		return nullptr;
 
-	auto name = tregistry.Nameof(ref_obj.GetID());
+	const auto* shape = tregistry.GetShape(ref_obj.GetID());
 
-	if (!type_name_is_reference(name))
+	if (!shape || !shape->IsReference())
 		return nullptr;
 
-	std::string_view rst_name = type_name_remove_reference(name);
-
-	if (type_name_is_const(rst_name))
+	if (shape->is_const)
 		return nullptr;
 
-	assert(!type_name_is_volatile(rst_name));
-
-	return { TypeID{ rst_name }, const_cast<void*>(ref_obj.GetPtr()) };
+	return { shape->raw, const_cast<void*>(ref_obj.GetPtr()) };
 }
 
 ConstObjectPtr ReflMngr::DereferenceAsConst(ConstObjectPtr ref_obj) const {
 	if (!ref_obj.Valid())
 		return nullptr;
 
-	auto name = tregistry.Nameof(ref_obj.GetID());
+	const auto* shape = tregistry.GetShape(ref_obj.GetID());
 
-	if (!type_name_is_reference(name))
+	if (!shape || !shape->IsReference())
 		return nullptr;
 
-	std::string_view ele_name = type_name_remove_reference(name);
-
-	auto rst_name = type_name_remove_const(ele_name);
-	assert(!type_name_is_volatile(rst_name));
-
-	return { TypeID{ rst_name }, ref_obj.GetPtr() };
+	return { shape->raw, ref_obj.GetPtr() };
 }
 
 TypeID ReflMngr::AddLValueReference(TypeID ID) {
@@ -2393,3 +3154,60 @@ ConstObjectPtr ReflMngr::AddConstLValueReference(ConstObjectPtr obj) {
 
 	return { newID, const_cast<void*>(obj.GetPtr()) };
 }
+
+//
+// MethodHandle
+/////////////////
+
+MethodHandle::MethodHandle(TypeID typeID, const MethodResolution& resolution) :
+	typeID{ typeID }
+{
+	if (!resolution)
+		return;
+
+	methodptr = &resolution.methodinfo->methodptr;
+	path = resolution.path;
+	plan = resolution.plan;
+}
+
+const void* MethodHandle::StaticCast_DerivedToMethodType(const void* obj) const noexcept {
+	for (const BaseInfo* baseinfo : path)
+		obj = baseinfo->StaticCast_DerivedToBase(obj);
+	return obj;
+}
+
+Destructor MethodHandle::Invoke(void* obj, void* result_buffer, ArgsBuffer args_buffer) const {
+	assert(Valid());
+
+	if (methodptr->IsStatic())
+		return Invoke(result_buffer, args_buffer);
+	if (methodptr->IsMemberConst())
+		return Invoke(static_cast<const void*>(obj), result_buffer, args_buffer);
+
+	void* base = const_cast<void*>(StaticCast_DerivedToMethodType(obj));
+	return details::CallWithArguments(&ScratchArena::ArgumentArena(), plan, args_buffer, [&](ArgsBuffer buffer) {
+		return methodptr->Invoke(base, result_buffer, buffer);
+	});
+}
+
+Destructor MethodHandle::Invoke(const void* obj, void* result_buffer, ArgsBuffer args_buffer) const {
+	assert(Valid());
+	assert(!methodptr->IsMemberVariable());
+
+	if (methodptr->IsStatic())
+		return Invoke(result_buffer, args_buffer);
+
+	const void* base = StaticCast_DerivedToMethodType(obj);
+	return details::CallWithArguments(&ScratchArena::ArgumentArena(), plan, args_buffer, [&](ArgsBuffer buffer) {
+		return methodptr->Invoke(base, result_buffer, buffer);
+	});
+}
+
+Destructor MethodHandle::Invoke(void* result_buffer, ArgsBuffer args_buffer) const {
+	assert(Valid());
+	assert(methodptr->IsStatic());
+
+	return details::CallWithArguments(&ScratchArena::ArgumentArena(), plan, args_buffer, [&](ArgsBuffer buffer) {
+		return methodptr->Invoke(result_buffer, buffer);
+	});
+}
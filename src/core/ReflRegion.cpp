@@ -0,0 +1,63 @@
+#include <UDRefl/ReflRegion.h>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+ReflRegion::ReflRegion(std::size_t initial_size, std::pmr::memory_resource* upstream) :
+	resource{ initial_size, upstream } {}
+
+ReflRegion::~ReflRegion() {
+	DestroyAll();
+}
+
+const MethodPtr* ReflRegion::GetDestructor(TypeID typeID) {
+	DtorCacheEntry& entry = dtor_cache[typeID.GetValue() % DtorCacheSize];
+	if (entry.typeID != typeID) {
+		entry.dtor = Mngr->GetDestructor(typeID);
+		entry.typeID = typeID;
+	}
+	return entry.dtor;
+}
+
+void ReflRegion::ReserveDestructor() {
+	if (dtors && dtors->size < DtorBlock::Capacity)
+		return;
+
+	auto* block = static_cast<DtorBlock*>(resource.allocate(sizeof(DtorBlock), alignof(DtorBlock)));
+	block->prev = dtors;
+	block->size = 0;
+	dtors = block;
+}
+
+ObjectPtr ReflRegion::New(TypeID typeID, std::span<const TypeID> argTypeIDs, ArgsBuffer args_buffer) {
+	const MethodPtr* dtor = GetDestructor(typeID);
+	if (dtor)
+		ReserveDestructor();
+
+	ObjectPtr obj = Mngr->MNew(typeID, &resource, argTypeIDs, args_buffer);
+	if (!obj)
+		return nullptr;
+
+	if (dtor) {
+		dtors->entries[dtors->size++] = { dtor, obj.GetPtr() };
+		++num_dtors;
+	}
+
+	return obj;
+}
+
+void ReflRegion::DestroyAll() noexcept {
+	for (DtorBlock* block = dtors; block; block = block->prev) {
+		for (std::size_t i = block->size; i > 0; i--) {
+			const DtorEntry& entry = block->entries[i - 1];
+			entry.dtor->Invoke(entry.obj, nullptr, nullptr);
+		}
+	}
+	dtors = nullptr;
+	num_dtors = 0;
+}
+
+void ReflRegion::Release() {
+	DestroyAll();
+	resource.release();
+}
@@ -0,0 +1,122 @@
+#include <UDRefl/ScratchArena.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	// ScratchScope nesting depth of the calling thread
+	static thread_local std::size_t scratch_scope_depth = 0;
+}
+
+//
+// ScratchArena
+/////////////////
+
+ScratchArena::ScratchArena(std::size_t chunk_size, std::pmr::memory_resource* upstream) noexcept :
+	upstream{ upstream }, chunk_size{ chunk_size } {}
+
+ScratchArena::~ScratchArena() { Release(); }
+
+std::byte* ScratchArena::Data(Chunk* chunk) noexcept {
+	return reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+}
+
+void ScratchArena::Rewind(Marker marker) noexcept {
+	cur = static_cast<Chunk*>(marker.chunk);
+	offset = marker.offset;
+}
+
+void ScratchArena::Release() noexcept {
+	Chunk* chunk = head;
+	while (chunk) {
+		Chunk* next = chunk->next;
+		upstream->deallocate(chunk, sizeof(Chunk) + chunk->size, alignof(std::max_align_t));
+		chunk = next;
+	}
+	head = nullptr;
+	cur = nullptr;
+	offset = 0;
+}
+
+std::size_t ScratchArena::Capacity() const noexcept {
+	std::size_t capacity = 0;
+	for (Chunk* chunk = head; chunk; chunk = chunk->next)
+		capacity += chunk->size;
+	return capacity;
+}
+
+void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+	// try the chunk in use, then the free ones after it
+	Chunk* chunk = cur ? cur : head;
+	std::size_t begin = cur ? offset : 0;
+	Chunk* last = nullptr;
+	while (chunk) {
+		void* p = Data(chunk) + begin;
+		std::size_t space = chunk->size - begin;
+		if (std::align(alignment, bytes, p, space)) {
+			cur = chunk;
+			offset = static_cast<std::size_t>(static_cast<std::byte*>(p) - Data(chunk)) + bytes;
+			return p;
+		}
+		last = chunk;
+		chunk = chunk->next;
+		begin = 0;
+	}
+
+	// grows geometrically, the header keeps the data max-aligned
+	std::size_t size = std::max(last ? 2 * last->size : chunk_size, bytes + alignment);
+	auto* new_chunk = static_cast<Chunk*>(upstream->allocate(sizeof(Chunk) + size, alignof(std::max_align_t)));
+	new_chunk->next = nullptr;
+	new_chunk->size = size;
+	if (last)
+		last->next = new_chunk;
+	else
+		head = new_chunk;
+
+	void* p = Data(new_chunk);
+	std::size_t space = size;
+	std::align(alignment, bytes, p, space);
+	cur = new_chunk;
+	offset = static_cast<std::size_t>(static_cast<std::byte*>(p) - Data(new_chunk)) + bytes;
+	return p;
+}
+
+void ScratchArena::do_deallocate(void* p, std::size_t bytes, std::size_t /*alignment*/) {
+	// LIFO release gives the bytes back, the others wait for a rewind
+	if (cur && static_cast<std::byte*>(p) + bytes == Data(cur) + offset)
+		offset = static_cast<std::size_t>(static_cast<std::byte*>(p) - Data(cur));
+}
+
+ScratchArena& ScratchArena::ArgumentArena() noexcept {
+	static thread_local ScratchArena arena;
+	return arena;
+}
+
+ScratchArena& ScratchArena::ResultArena() noexcept {
+	static thread_local ScratchArena arena;
+	return arena;
+}
+
+//
+// ScratchScope
+/////////////////
+
+ScratchScope::ScratchScope() noexcept : scope{ ScratchArena::ResultArena() } {
+	++details::scratch_scope_depth;
+}
+
+ScratchScope::~ScratchScope() {
+	assert(details::scratch_scope_depth > 0);
+	--details::scratch_scope_depth;
+}
+
+std::pmr::memory_resource* ScratchScope::ResultResource() noexcept {
+	if (details::scratch_scope_depth > 0)
+		return &ScratchArena::ResultArena();
+	else
+		return std::pmr::get_default_resource();
+}
@@ -0,0 +1,187 @@
+#include <UDRefl/ThreadPool.h>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+namespace Ubpa::UDRefl::details {
+	// the pool and the index of the calling worker
+	static thread_local const ThreadPool* current_pool = nullptr;
+	static thread_local std::size_t current_worker = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t num_workers) {
+	num_workers = std::max<std::size_t>(num_workers, 1);
+
+	workers.reserve(num_workers);
+	for (std::size_t i = 0; i < num_workers; i++)
+		workers.push_back(std::make_unique<Worker>());
+
+	// the deques are ready before any worker steals
+	for (std::size_t i = 0; i < num_workers; i++)
+		workers[i]->thread = std::thread{ [this, i] { Run(i); } };
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard lock{ sleep_mutex };
+		stop = true;
+	}
+	sleep_cv.notify_all();
+
+	for (auto& worker : workers)
+		worker->thread.join();
+}
+
+std::size_t ThreadPool::DefaultNumWorkers() noexcept {
+	return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+ThreadPool& ThreadPool::Default() {
+	static ThreadPool pool;
+	return pool;
+}
+
+std::size_t ThreadPool::WorkerIndex() const noexcept {
+	return details::current_pool == this ? details::current_worker : NumWorkers();
+}
+
+std::size_t ThreadPool::DefaultGrain(std::size_t count) const noexcept {
+	const std::size_t num_chunks = 4 * NumWorkers();
+	return std::max<std::size_t>((count + num_chunks - 1) / num_chunks, 1);
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+	std::size_t index = WorkerIndex();
+	if (index == NumWorkers())
+		index = next_worker.fetch_add(1, std::memory_order_relaxed) % NumWorkers();
+
+	{
+		Worker& worker = *workers[index];
+		std::lock_guard lock{ worker.mutex };
+		worker.tasks.push_back(std::move(task));
+	}
+
+	{
+		std::lock_guard lock{ sleep_mutex };
+		num_pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	sleep_cv.notify_one();
+}
+
+bool ThreadPool::TryPop(std::size_t index, std::function<void()>& task) {
+	{
+		Worker& worker = *workers[index];
+		std::lock_guard lock{ worker.mutex };
+		if (!worker.tasks.empty()) {
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			num_pending.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	for (std::size_t i = 1; i < NumWorkers(); i++) {
+		Worker& victim = *workers[(index + i) % NumWorkers()];
+		std::lock_guard lock{ victim.mutex };
+		if (!victim.tasks.empty()) {
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			num_pending.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::Run(std::size_t index) {
+	details::current_pool = this;
+	details::current_worker = index;
+
+	std::function<void()> task;
+	while (true) {
+		if (TryPop(index, task)) {
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock lock{ sleep_mutex };
+		sleep_cv.wait(lock, [&] { return stop || num_pending.load(std::memory_order_relaxed) > 0; });
+		if (stop && num_pending.load(std::memory_order_relaxed) <= 0)
+			return;
+	}
+}
+
+void ThreadPool::ParallelFor(
+	std::size_t count,
+	std::size_t grain,
+	const std::function<void(std::size_t worker, std::size_t chunk, std::size_t begin, std::size_t end)>& func)
+{
+	if (count == 0)
+		return;
+
+	if (grain == 0)
+		grain = DefaultGrain(count);
+
+	const std::size_t num_chunks = NumChunks(count, grain);
+
+	// shared with the helper tasks, which may run after the call returns and find no chunk left
+	struct Join {
+		std::atomic<std::size_t> next_chunk{ 0 };
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::size_t remaining;
+		std::exception_ptr error;
+	};
+	auto join = std::make_shared<Join>();
+	join->remaining = num_chunks;
+
+	// claims and runs the next chunk of this call, false if all are claimed
+	// - <func> is only touched for a claimed chunk, the call waits for it
+	auto run_next = [this, join, &func, count, grain, num_chunks] {
+		const std::size_t chunk = join->next_chunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= num_chunks)
+			return false;
+
+		const std::size_t begin = chunk * grain;
+		const std::size_t end = std::min(begin + grain, count);
+
+		std::exception_ptr error;
+		try {
+			func(WorkerIndex(), chunk, begin, end);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+
+		std::lock_guard lock{ join->mutex };
+		if (error && !join->error)
+			join->error = error;
+		if (--join->remaining == 0)
+			join->cv.notify_all();
+		return true;
+	};
+
+	const std::size_t num_helpers = std::min(num_chunks, NumWorkers());
+	for (std::size_t i = 0; i < num_helpers; i++)
+		Submit([run_next] { while (run_next()) {} });
+
+	// a waiting worker only runs the chunks of this call, never another task,
+	// so the chunk (and its per-worker state) on its stack isn't re-entered
+	if (WorkerIndex() != NumWorkers()) {
+		while (run_next()) {}
+	}
+
+	{
+		std::unique_lock lock{ join->mutex };
+		join->cv.wait(lock, [&] { return join->remaining == 0; });
+	}
+
+	if (join->error)
+		std::rethrow_exception(join->error);
+}
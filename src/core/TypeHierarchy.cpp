@@ -0,0 +1,26 @@
+#include <UDRefl/TypeHierarchy.h>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+void TypeHierarchy::Node::Merge(const Node& base) {
+	if (bases.size() < base.bases.size())
+		bases.resize(base.bases.size(), 0);
+
+	for (std::size_t i = 0; i < base.bases.size(); i++)
+		bases[i] |= base.bases[i];
+}
+
+const TypeHierarchy::Node& TypeHierarchy::Insert(TypeID typeID, std::vector<std::uint64_t> bases) {
+	std::lock_guard lock{ mutex };
+
+	if (const Node* node = nodes.Find(typeID))
+		return *node;
+
+	const std::size_t index = nodes.Size();
+	if (bases.size() <= index / 64)
+		bases.resize(index / 64 + 1, 0);
+	bases[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+
+	return nodes.Insert(typeID, Node{ index, std::move(bases) });
+}
@@ -0,0 +1,63 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct A {
+	float a;
+	float Get() const noexcept { return a; }
+};
+
+struct B : A {
+	float b;
+	void Scale(float k) noexcept { a *= k; b *= k; }
+	void Scale(float ka, float kb) noexcept { a *= ka; b *= kb; }
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<A>();
+		ReflMngr::Instance().AddField<&A::a>("a");
+		ReflMngr::Instance().AddMethod<&A::Get>("Get");
+
+		ReflMngr::Instance().RegisterType<B>();
+		ReflMngr::Instance().AddBases<B, A>();
+		ReflMngr::Instance().AddField<&B::b>("b");
+		ReflMngr::Instance().AddMethod<MemFuncOf<void(float)>::get(&B::Scale)>("Scale");
+		ReflMngr::Instance().AddMethod<MemFuncOf<void(float, float)>::get(&B::Scale)>("Scale");
+	}
+
+	{ // duplicated keys are rejected, not grown forever
+		PerfectHashTable<StrID, int> table;
+		if (table.Build({ { StrID{ "a" }, 0 }, { StrID{ "b" }, 1 }, { StrID{ "a" }, 2 } }) || table.Find(StrID{ "a" }))
+			std::cout << "[FAIL] duplicated keys" << std::endl;
+		if (!table.Build({ { StrID{ "a" }, 0 }, { StrID{ "b" }, 1 } }) || *table.Find(StrID{ "b" }) != 1)
+			std::cout << "[FAIL] unique keys" << std::endl;
+	}
+
+	if (!ReflMngr::Instance().Freeze())
+		std::cout << "[FAIL] Freeze" << std::endl;
+	std::cout << "frozen: " << ReflMngr::Instance().IsFrozen() << std::endl;
+
+	auto b = ReflMngr::Instance().MakeShared(TypeID_of<B>);
+	b->RWVar("a") = 1.f;
+	b->RWVar("b") = 2.f;
+
+	b->Invoke<void>("Scale", 2.f);
+	b->Invoke<void>("Scale", 3.f, 0.5f);
+
+	std::cout << "a: " << b->RVar("a") << std::endl;
+	std::cout << "b: " << b->RVar("b") << std::endl;
+	std::cout << "Get: " << b->Invoke<float>("Get") << std::endl;
+
+	// register more after unfreezing
+	ReflMngr::Instance().Unfreeze();
+	ReflMngr::Instance().AddMemberMethod("Sum", [](const B& b) { return b.a + b.b; });
+	ReflMngr::Instance().Freeze();
+
+	std::cout << "Sum: " << b->Invoke<float>("Sum") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Base {
+	float sum{ 0.f };
+
+	void Add(float v) {
+		std::cout << "void Base::Add(float)" << std::endl;
+		sum += v;
+	}
+};
+
+struct Derived : Base {
+	void Add(float v) {
+		std::cout << "void Derived::Add(float)" << std::endl;
+		sum += 2 * v;
+	}
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Base>();
+		ReflMngr::Instance().AddField<&Base::sum>("sum");
+		ReflMngr::Instance().AddMethod<&Base::Add>("Add");
+
+		ReflMngr::Instance().RegisterType<Derived>();
+		ReflMngr::Instance().AddBases<Derived, Base>();
+	}
+
+	auto d = ReflMngr::Instance().MakeShared(TypeID_of<Derived>);
+
+	// resolved once (Derived -> Base, Base::Add), then cached
+	for (int i = 0; i < 3; i++)
+		d->Invoke<void>("Add", 1.f);
+	std::cout << "sum: " << d->RVar("sum") << std::endl;
+
+	{
+		std::array argTypeIDs = { TypeID_of<float> };
+		const auto& resolution = ReflMngr::Instance().ResolveOverload(MethodSearchMode::Variable, TypeID_of<Derived>, StrID{ "Add" }, argTypeIDs);
+		std::cout << "bases: " << resolution.path.size() << std::endl;
+		std::cout << "pass through: " << resolution.plan.IsPassThrough() << std::endl;
+	}
+
+	// AddMethod clears the cache
+	ReflMngr::Instance().AddMethod<&Derived::Add>("Add");
+	d->Invoke<void>("Add", 1.f);
+	std::cout << "sum: " << d->RVar("sum") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Transform {
+	float x{ 0.f };
+
+	void Translate(float dx) noexcept { x += dx; }
+	float Get() const noexcept { return x; }
+	static float Scale(float v, float k) noexcept { return v * k; }
+};
+
+struct Node : Transform {
+	int id{ 0 };
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Transform>();
+		ReflMngr::Instance().AddField<&Transform::x>("x");
+		ReflMngr::Instance().AddMethod<&Transform::Translate>("Translate");
+		ReflMngr::Instance().AddMethod<&Transform::Get>("Get");
+		ReflMngr::Instance().AddStaticMethod(TypeID_of<Transform>, "Scale", [](float v, float k) { return Transform::Scale(v, k); });
+
+		ReflMngr::Instance().RegisterType<Node>();
+		ReflMngr::Instance().AddField<&Node::id>("id");
+		ReflMngr::Instance().AddBases<Node, Transform>();
+	}
+
+	// resolve once
+	MethodHandle translate = ReflMngr::Instance().ResolveMethod<float>(TypeID_of<Node>, StrID{ "Translate" });
+	MethodHandle get = ReflMngr::Instance().ResolveMethod(TypeID_of<Node>, StrID{ "Get" }, {}, MethodSearchMode::Const);
+	MethodHandle scale = ReflMngr::Instance().ResolveMethod<float, float>(TypeID_of<Node>, StrID{ "Scale" }, MethodSearchMode::Static);
+	MethodHandle none = ReflMngr::Instance().ResolveMethod<float>(TypeID_of<Node>, StrID{ "Get" });
+
+	std::cout << "valid: " << translate.Valid() << get.Valid() << scale.Valid() << none.Valid() << std::endl;
+
+	// invoke many times
+	std::vector<Node> nodes(4);
+	for (std::size_t i = 0; i < nodes.size(); i++) {
+		float dx = static_cast<float>(i);
+		std::array<void*, 1> args = { &dx };
+		translate.Invoke(static_cast<void*>(&nodes[i]), nullptr, args.data());
+	}
+
+	for (const auto& node : nodes) {
+		float x;
+		get.Invoke(static_cast<const void*>(&node), &x, nullptr);
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+
+	{
+		float v = 3.f, k = 2.f;
+		std::array<void*, 2> args = { &v, &k };
+		float rst;
+		scale.Invoke(&rst, args.data());
+		std::cout << "Scale: " << rst << std::endl;
+	}
+
+	return 0;
+}
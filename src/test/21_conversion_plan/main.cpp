@@ -0,0 +1,55 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Accumulator {
+	double sum{ 0. };
+
+	void Add(double v) noexcept { sum += v; }
+	void AddRef(const double& v) noexcept { sum += v; }
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Accumulator>();
+		ReflMngr::Instance().AddField<&Accumulator::sum>("sum");
+		ReflMngr::Instance().AddMethod<&Accumulator::Add>("Add");
+		ReflMngr::Instance().AddMethod<&Accumulator::AddRef>("AddRef");
+	}
+
+	auto acc = ReflMngr::Instance().MakeShared(TypeID_of<Accumulator>);
+
+	// double <- double{float}, const double& <- double{int}
+	acc->Invoke<void>("Add", 1.5f);
+	acc->Invoke<void>("AddRef", 2);
+	std::cout << "sum: " << acc->RVar("sum") << std::endl;
+
+	{ // compiled once, stored in the resolution
+		std::array argTypeIDs = { TypeID_of<float> };
+		const auto& resolution = ReflMngr::Instance().ResolveOverload(MethodSearchMode::Variable, TypeID_of<Accumulator>, StrID{ "Add" }, argTypeIDs);
+		const auto& plan = resolution.plan;
+		std::cout << "pass through: " << plan.IsPassThrough() << std::endl;
+		std::cout << "steps: " << plan.GetSteps().size() << std::endl;
+		std::cout << "fits inline: " << plan.FitsInline() << std::endl;
+	}
+
+	{ // no conversion
+		std::array argTypeIDs = { TypeID_of<double> };
+		const auto& resolution = ReflMngr::Instance().ResolveOverload(MethodSearchMode::Variable, TypeID_of<Accumulator>, StrID{ "AddRef" }, argTypeIDs);
+		std::cout << "pass through: " << resolution.plan.IsPassThrough() << std::endl;
+	}
+
+	// handles share the plan
+	MethodHandle add = ReflMngr::Instance().ResolveMethod<float>(TypeID_of<Accumulator>, StrID{ "Add" });
+	for (int i = 0; i < 4; i++) {
+		float v = 0.25f;
+		std::array<void*, 1> args = { &v };
+		add.Invoke(acc->GetPtr(), nullptr, args.data());
+	}
+	std::cout << "sum: " << acc->RVar("sum") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Object {
+	int id{ 0 };
+	int GetID() const noexcept { return id; }
+};
+
+struct Component : Object {
+	bool enabled{ true };
+	void SetEnabled(bool v) noexcept { enabled = v; }
+};
+
+struct Behaviour : Component {
+	float weight{ 1.f };
+};
+
+struct Renderer : Behaviour {
+	int layer{ 0 };
+	int GetID() const noexcept { return -id; } // hides Object::GetID
+};
+
+struct MeshRenderer : Renderer {
+	int mesh{ 0 };
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Object>();
+		ReflMngr::Instance().AddField<&Object::id>("id");
+		ReflMngr::Instance().AddMethod<&Object::GetID>("GetID");
+
+		ReflMngr::Instance().RegisterType<Component>();
+		ReflMngr::Instance().AddBases<Component, Object>();
+		ReflMngr::Instance().AddField<&Component::enabled>("enabled");
+		ReflMngr::Instance().AddMethod<&Component::SetEnabled>("SetEnabled");
+
+		ReflMngr::Instance().RegisterType<Behaviour>();
+		ReflMngr::Instance().AddBases<Behaviour, Component>();
+
+		ReflMngr::Instance().RegisterType<Renderer>();
+		ReflMngr::Instance().AddBases<Renderer, Behaviour>();
+		ReflMngr::Instance().AddMethod<&Renderer::GetID>("GetID");
+
+		ReflMngr::Instance().RegisterType<MeshRenderer>();
+		ReflMngr::Instance().AddBases<MeshRenderer, Renderer>();
+	}
+
+	ReflMngr::Instance().Freeze();
+
+	{ // inherited overloads are in the table of the most-derived type
+		const auto* ftypeinfo = ReflMngr::Instance().GetFrozenTypeInfo(TypeID_of<MeshRenderer>);
+		const auto* getID = ftypeinfo->flat_methodinfos.Find(StrID{ "GetID" });
+		const auto* setEnabled = ftypeinfo->flat_methodinfos.Find(StrID{ "SetEnabled" });
+		std::cout << "GetID overloads: " << getID->size() << std::endl;
+		std::cout << "GetID path: " << (*getID)[0].path.size() << ", " << (*getID)[1].path.size() << std::endl;
+		std::cout << "SetEnabled path: " << (*setEnabled)[0].path.size() << std::endl;
+	}
+
+	auto mr = ReflMngr::Instance().MakeShared(TypeID_of<MeshRenderer>);
+	mr->RWVar("id") = 3;
+	mr->Invoke<void>("SetEnabled", false);
+
+	std::cout << "enabled: " << mr->RVar("enabled").As<bool>() << std::endl;
+	std::cout << "GetID: " << mr->Invoke<int>("GetID") << std::endl;
+
+	auto b = ReflMngr::Instance().MakeShared(TypeID_of<Behaviour>);
+	b->RWVar("id") = 3;
+	std::cout << "Behaviour GetID: " << b->Invoke<int>("GetID") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Object { int id{ 0 }; };
+struct Named { float name{ 0.f }; };
+struct Component : Named, Object { bool enabled{ true }; }; // Object isn't at offset 0
+struct Transform : Component { float x{ 0.f }; };
+
+struct A { float a{ 0.f }; };
+struct B : virtual A { float b{ 0.f }; };
+struct C : virtual A { float c{ 0.f }; };
+struct D : B, C { float d{ 0.f }; };
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Object>();
+		ReflMngr::Instance().AddField<&Object::id>("id");
+
+		ReflMngr::Instance().RegisterType<Named>();
+		ReflMngr::Instance().AddField<&Named::name>("name");
+
+		ReflMngr::Instance().RegisterType<Component>();
+		ReflMngr::Instance().AddBases<Component, Named, Object>();
+		ReflMngr::Instance().AddField<&Component::enabled>("enabled");
+
+		ReflMngr::Instance().RegisterType<Transform>();
+		ReflMngr::Instance().AddBases<Transform, Component>();
+		ReflMngr::Instance().AddField<&Transform::x>("x");
+
+		ReflMngr::Instance().RegisterType<A>();
+		ReflMngr::Instance().AddField<&A::a>("a");
+
+		ReflMngr::Instance().RegisterType<B>();
+		ReflMngr::Instance().AddBases<B, A>();
+		ReflMngr::Instance().AddField<&B::b>("b");
+
+		ReflMngr::Instance().RegisterType<C>();
+		ReflMngr::Instance().AddBases<C, A>();
+		ReflMngr::Instance().AddField<&C::c>("c");
+
+		ReflMngr::Instance().RegisterType<D>();
+		ReflMngr::Instance().AddBases<D, B, C>();
+		ReflMngr::Instance().AddField<&D::d>("d");
+	}
+
+	ReflMngr::Instance().Freeze();
+
+	{ // non virtual bases fold into a constant offset
+		const auto* ftypeinfo = ReflMngr::Instance().GetFrozenTypeInfo(TypeID_of<Transform>);
+		const auto& id = ftypeinfo->flat_fieldinfos.Find(StrID{ "id" })->front();
+		Transform t;
+		std::cout << "id offset: " << (reinterpret_cast<const std::uint8_t*>(&t.id) - reinterpret_cast<const std::uint8_t*>(&t) == id.offset) << std::endl;
+		std::cout << "id path: " << id.path.size() << std::endl;
+	}
+
+	{ // virtual bases fall back to casts
+		const auto* ftypeinfo = ReflMngr::Instance().GetFrozenTypeInfo(TypeID_of<D>);
+		const auto& a = ftypeinfo->flat_fieldinfos.Find(StrID{ "a" })->front();
+		std::cout << "a path: " << a.path.size() << std::endl;
+	}
+
+	auto t = ReflMngr::Instance().MakeShared(TypeID_of<Transform>);
+	t->RWVar("id") = 3;
+	t->RWVar("name") = 1.f;
+	t->RWVar("enabled") = false;
+	t->RWVar("x") = 2.f;
+	std::cout << "id: " << t->RVar("id") << std::endl;
+	std::cout << "name: " << t->RVar("name") << std::endl;
+	std::cout << "enabled: " << t->RVar("enabled") << std::endl;
+	std::cout << "x: " << t->RVar("x") << std::endl;
+	std::cout << "Object::id: " << t.As<Transform>().id << std::endl;
+
+	auto d = ReflMngr::Instance().MakeShared(TypeID_of<D>);
+	d->RWVar("a") = 1.f;
+	d->RWVar("b") = 3.f;
+	d->RWVar("c") = 4.f;
+	d->RWVar("d") = 5.f;
+	std::cout << "a: " << d->RVar("a") << std::endl;
+	std::cout << "A::a: " << d.As<D>().a << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Named { int name{ 0 }; };
+struct Transform { float x{ 0.f }; };
+struct Node : Named, Transform { int id{ 0 }; const int version{ 1 }; }; // Transform isn't at offset 0
+
+struct A { float a{ 0.f }; };
+struct B : virtual A { float b{ 0.f }; };
+struct C : virtual A { float c{ 0.f }; };
+struct D : B, C { float d{ 0.f }; };
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Named>();
+		ReflMngr::Instance().AddField<&Named::name>("name");
+
+		ReflMngr::Instance().RegisterType<Transform>();
+		ReflMngr::Instance().AddField<&Transform::x>("x");
+
+		ReflMngr::Instance().RegisterType<Node>();
+		ReflMngr::Instance().AddBases<Node, Named, Transform>();
+		ReflMngr::Instance().AddField<&Node::id>("id");
+		ReflMngr::Instance().AddField<&Node::version>("version");
+
+		ReflMngr::Instance().RegisterType<A>();
+		ReflMngr::Instance().AddField<&A::a>("a");
+
+		ReflMngr::Instance().RegisterType<B>();
+		ReflMngr::Instance().AddBases<B, A>();
+		ReflMngr::Instance().AddField<&B::b>("b");
+
+		ReflMngr::Instance().RegisterType<C>();
+		ReflMngr::Instance().AddBases<C, A>();
+		ReflMngr::Instance().AddField<&C::c>("c");
+
+		ReflMngr::Instance().RegisterType<D>();
+		ReflMngr::Instance().AddBases<D, B, C>();
+		ReflMngr::Instance().AddField<&D::d>("d");
+	}
+
+	// resolve once
+	FieldHandle x = ReflMngr::Instance().ResolveField(TypeID_of<Node>, StrID{ "x" });
+	FieldHandle id = ReflMngr::Instance().ResolveField(TypeID_of<Node>, StrID{ "id" });
+	FieldHandle none = ReflMngr::Instance().ResolveField(TypeID_of<Node>, StrID{ "y" });
+
+	std::cout << "valid: " << x.Valid() << id.Valid() << none.Valid() << std::endl;
+
+	// read/write many times
+	std::vector<Node> nodes(4);
+	for (std::size_t i = 0; i < nodes.size(); i++) {
+		x.Set(&nodes[i], static_cast<float>(i));
+		id.Set(&nodes[i], static_cast<int>(i * 10));
+	}
+
+	for (const auto& node : nodes)
+		std::cout << x.Get<float>(&node) << "/" << node.x << " " << id.RVar(&node) << " ";
+	std::cout << std::endl;
+
+	{ // const field, wrong value type: no write
+		FieldHandle version = ReflMngr::Instance().ResolveField(TypeID_of<Node>, StrID{ "version" });
+		if (version.Set(&nodes[0], 2) || nodes[0].version != 1)
+			std::cout << "[FAIL] const field" << std::endl;
+		if (id.Set(&nodes[0], 2.f) || nodes[0].id != 0)
+			std::cout << "[FAIL] value type" << std::endl;
+	}
+
+	{ // virtual base, frozen
+		ReflMngr::Instance().Freeze();
+		FieldHandle a = ReflMngr::Instance().ResolveField(TypeID_of<D>, StrID{ "a" });
+		D d;
+		a.RWVar(&d) = 2.f;
+		std::cout << "a: " << a.Get<float>(&d) << "/" << d.a << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct A { float a{ 0.f }; };
+struct B : virtual A { float b{ 0.f }; };
+
+struct Vec {
+	float data[2]{ 0.f, 0.f };
+	static inline int count{ 0 };
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<A>();
+		ReflMngr::Instance().AddField<&A::a>("a");
+
+		ReflMngr::Instance().RegisterType<B>();
+		ReflMngr::Instance().AddBases<B, A>();
+		ReflMngr::Instance().AddField<&B::b>("b");                            // virtual, stateless
+		ReflMngr::Instance().AddField(TypeID_of<B>, "rb", &B::b);             // virtual, member pointer in the context
+
+		ReflMngr::Instance().RegisterType<Vec>();
+		ReflMngr::Instance().AddField("x", [](Vec* v) { return &v->data[0]; }); // stateless functor
+		std::size_t i = 1;
+		ReflMngr::Instance().AddField("y", [i](Vec* v) { return &v->data[i]; }); // functor in the context
+		ReflMngr::Instance().AddField(TypeID_of<Vec>, "count", &Vec::count);     // static
+		ReflMngr::Instance().AddDynamicField<const int>(TypeID_of<Vec>, "dim", 2); // dynamic buffer
+	}
+
+	std::cout << "compact: " << (sizeof(FieldPtr) <= sizeof(TypeID) + 2 * sizeof(void*) + sizeof(SharedBuffer)) << std::endl;
+
+	auto b = ReflMngr::Instance().MakeShared(TypeID_of<B>);
+	b->RWVar("b") = 2.f;
+	std::cout << "b: " << b->RVar("b") << " rb: " << b->RVar("rb") << std::endl;
+	b->RWVar("rb") = 3.f;
+	std::cout << "b: " << b.As<B>().b << std::endl;
+
+	auto v = ReflMngr::Instance().MakeShared(TypeID_of<Vec>);
+	v->RWVar("x") = 1.f;
+	v->RWVar("y") = 2.f;
+	v->RWVar("count") = 5;
+	std::cout << "x: " << v.As<Vec>().data[0] << " y: " << v.As<Vec>().data[1] << std::endl;
+	std::cout << "count: " << Vec::count << " dim: " << v->RVar("dim") << std::endl;
+
+	for (const auto& [type, field, var] : v->GetTypeFieldRVars()) {
+		std::cout
+			<< ReflMngr::Instance().nregistry.Nameof(field.ID)
+			<< ": " << var
+			<< std::endl;
+	}
+
+	return 0;
+}
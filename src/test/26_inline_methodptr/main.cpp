@@ -0,0 +1,67 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x{ 0.f };
+	float y{ 0.f };
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Vec>();
+	ReflMngr::Instance().AddField<&Vec::x>("x");
+	ReflMngr::Instance().AddField<&Vec::y>("y");
+
+	// captureless -> function pointer
+	MethodPtr norm2 = ReflMngr::Instance().GenerateMemberMethodPtr([](const Vec& v) { return v.x * v.x + v.y * v.y; });
+	// small capture -> inline
+	float k = 2.f;
+	MethodPtr scale = ReflMngr::Instance().GenerateMemberMethodPtr([k](Vec& v) { v.x *= k; v.y *= k; });
+	// large capture -> out of line
+	std::string prefix = "a long prefix that does not fit into the inline buffer";
+	MethodPtr name = ReflMngr::Instance().GenerateStaticMethodPtr([prefix](std::size_t i) { return prefix.size() + i; });
+	// many parameters -> heap ParamList
+	MethodPtr sum = ReflMngr::Instance().GenerateStaticMethodPtr([](int a, int b, int c, int d, int e) { return a + b + c + d + e; });
+
+	std::cout << "kind: "
+		<< (norm2.GetKind() == MethodPtr::Kind::MemberConst)
+		<< (scale.GetKind() == MethodPtr::Kind::MemberVariableCallable)
+		<< (name.GetKind() == MethodPtr::Kind::StaticCallable)
+		<< (sum.GetKind() == MethodPtr::Kind::Static)
+		<< std::endl;
+	std::cout << "param list: "
+		<< norm2.GetParamList().size() << norm2.GetParamList().IsInline() << " "
+		<< sum.GetParamList().size() << sum.GetParamList().IsInline() << std::endl;
+
+	Vec v{ 1.f, 2.f };
+	{
+		float rst;
+		norm2.Invoke(static_cast<const void*>(&v), &rst, nullptr);
+		std::cout << "norm2: " << rst << std::endl;
+	}
+	{
+		MethodPtr copied_scale = scale;
+		copied_scale.Invoke(static_cast<void*>(&v), nullptr, nullptr);
+		std::cout << "scale: " << v.x << ", " << v.y << std::endl;
+	}
+	{
+		std::size_t i = 3;
+		std::array<void*, 1> args = { &i };
+		std::size_t rst;
+		name.Invoke(&rst, args.data());
+		std::cout << "name: " << rst << std::endl;
+	}
+	{
+		int a = 1, b = 2, c = 3, d = 4, e = 5;
+		std::array<void*, 5> args = { &a, &b, &c, &d, &e };
+		int rst;
+		sum.Invoke(&rst, args.data());
+		std::cout << "sum: " << rst << std::endl;
+	}
+
+	return 0;
+}
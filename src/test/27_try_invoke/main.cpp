@@ -0,0 +1,56 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Base {
+	float Scale(float v) const { return 2.f * v; }
+};
+
+struct Derived : Base {
+	float Scale(const float& v) const { return 3.f * v; }
+};
+
+struct Flag {
+	bool on{ false };
+	Flag(bool on) : on{ on } {}
+	explicit operator bool() const noexcept { return on; }
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Base>();
+		ReflMngr::Instance().AddMethod<&Base::Scale>("Scale");
+
+		ReflMngr::Instance().RegisterType<Derived>();
+		ReflMngr::Instance().AddBases<Derived, Base>();
+		ReflMngr::Instance().AddMethod<&Derived::Scale>("Scale");
+
+		ReflMngr::Instance().RegisterType<Flag>();
+		ReflMngr::Instance().AddField<&Flag::on>("on");
+		ReflMngr::Instance().AddConstructor<Flag, bool>();
+	}
+
+	// one pass ranks Derived::Scale(const float&) as compatible, Base::Scale(float) as priority
+	auto d = ReflMngr::Instance().MakeShared(TypeID_of<Derived>);
+	std::cout << "Scale: " << d->Invoke<float>("Scale", 1.f) << std::endl;
+
+	// not invocable -> std::nullopt, no second lookup
+	auto missing = d->TryInvoke<float>("Missing", 1.f);
+	std::cout << "Missing: " << missing.has_value() << std::endl;
+	auto scaled = ReflMngr::Instance().TryInvoke<float>(ObjectPtr{ d }, StrID{ "Scale" }, 2.f);
+	std::cout << "TryInvoke: " << scaled.has_value() << " " << scaled.value_or(0.f) << std::endl;
+
+	// New resolves the ctor once
+	auto on = ReflMngr::Instance().MakeShared(TypeID_of<Flag>, true);
+	auto off = ReflMngr::Instance().MakeShared(TypeID_of<Flag>, false);
+	auto none = ReflMngr::Instance().New(TypeID_of<Flag>, 1.f, 2.f);
+	std::cout << "New: " << (none.GetPtr() == nullptr) << std::endl;
+
+	// operator bool: one TryInvoke
+	std::cout << "bool: " << static_cast<bool>(on) << static_cast<bool>(off) << static_cast<bool>(d) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include <UDRefl/UDRefl.h>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Point {
+	float x{ 0.f };
+	float y{ 0.f };
+	float Sum() const noexcept { return x + y; }
+};
+
+// registered while the readers run
+struct Point3 : Point {
+	float z{ 0.f };
+};
+
+int main() {
+	{ // register
+		ReflMngr::Instance().RegisterType<Point>();
+		ReflMngr::Instance().AddField<&Point::x>("x");
+		ReflMngr::Instance().AddField<&Point::y>("y");
+		ReflMngr::Instance().AddMethod<&Point::Sum>("Sum");
+	}
+
+	// frozen: readers are lock-free, registering more (methods, a new type) publishes new tables
+	ReflMngr::Instance().Freeze();
+
+	constexpr std::size_t num_readers = 4;
+	constexpr int num_methods = 64;
+
+	std::atomic<bool> done{ false };
+	std::atomic<std::size_t> num_errors{ 0 };
+	std::atomic<std::size_t> num_reads{ 0 };
+
+	std::vector<std::thread> readers;
+	for (std::size_t i = 0; i < num_readers; i++) {
+		readers.emplace_back([&]() {
+			Point p{ 1.f, 2.f };
+			ObjectPtr ptr{ TypeID_of<Point>, &p };
+			Point3 q;
+			q.x = 1.f;
+			q.y = 2.f;
+			q.z = 4.f;
+			ObjectPtr ptr3{ TypeID_of<Point3>, &q };
+			while (!done.load()) {
+				if (ptr.Invoke<float>("Sum") != 3.f)
+					++num_errors;
+				if (ptr.RVar("y").As<float>() != 2.f)
+					++num_errors;
+				// "Scale<n>" is either not published yet or returns n
+				for (int n : { 0, num_methods / 2, num_methods - 1 }) {
+					auto scaled = ptr.TryInvoke<float>(StrID{ "Scale" + std::to_string(n) });
+					if (scaled && *scaled != static_cast<float>(n) * 3.f)
+						++num_errors;
+				}
+				// Point3 is published at once with its base and field, or not at all
+				if (ConstObjectPtr z = ptr3.RVar("z")) {
+					if (z.As<float>() != 4.f)
+						++num_errors;
+					if (!ReflMngr::Instance().IsDerivedFrom(TypeID_of<Point3>, TypeID_of<Point>))
+						++num_errors;
+					if (ReflMngr::Instance().StaticCast_DerivedToBase(ptr3, TypeID_of<Point>).GetPtr() != static_cast<Point*>(&q))
+						++num_errors;
+					if (ptr3.RVar("y").As<float>() != 2.f || ptr3.Invoke<float>("Sum") != 3.f)
+						++num_errors;
+				}
+				++num_reads;
+			}
+		});
+	}
+
+	std::thread writer([&]() {
+		for (int n = 0; n < num_methods; n++) {
+			if (n == num_methods / 2) { // a new type, its names go through the ID registries
+				ReflMngr::WriteGuard guard;
+				ReflMngr::Instance().RegisterType<Point3>();
+				ReflMngr::Instance().AddBases<Point3, Point>();
+				ReflMngr::Instance().AddField<&Point3::z>("z");
+			}
+			ReflMngr::Instance().AddMemberMethod("Scale" + std::to_string(n), [n](const Point& p) {
+				return static_cast<float>(n) * p.Sum();
+			});
+		}
+		{ // a batch is published once
+			ReflMngr::WriteGuard guard;
+			ReflMngr::Instance().AddMemberMethod("Diff", [](const Point& p) { return p.y - p.x; });
+			ReflMngr::Instance().AddMemberMethod("Prod", [](const Point& p) { return p.x * p.y; });
+		}
+	});
+
+	writer.join();
+	while (num_reads.load() < num_readers * 16)
+		std::this_thread::yield();
+	done = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	std::cout << "errors: " << num_errors.load() << std::endl;
+
+	Point p{ 1.f, 2.f };
+	ObjectPtr ptr{ TypeID_of<Point>, &p };
+	std::cout << "frozen: " << ReflMngr::Instance().IsFrozen() << std::endl;
+	std::cout << "Scale63: " << ptr.Invoke<float>("Scale63") << std::endl;
+	std::cout << "Diff: " << ptr.Invoke<float>("Diff") << std::endl;
+	std::cout << "Prod: " << ptr.Invoke<float>("Prod") << std::endl;
+
+	Point3 q;
+	q.z = 4.f;
+	std::cout << "z: " << ObjectPtr{ TypeID_of<Point3>, &q }.RVar("z").As<float>() << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x;
+	float y;
+	Vec operator+(const Vec& v) const noexcept {
+		return { x + v.x, y + v.y };
+	}
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Vec>();
+	ReflMngr::Instance().AddField<&Vec::x>("x");
+	ReflMngr::Instance().AddField<&Vec::y>("y");
+	ReflMngr::Instance().AddMemberMethod("Scale", [](const Vec& v, double s) {
+		return Vec{ static_cast<float>(v.x * s), static_cast<float>(v.y * s) };
+	});
+
+	Vec v{ 1.f, 2.f };
+	ObjectPtr ptr{ TypeID_of<Vec>, &v };
+
+	{ // arena: bump, LIFO deallocation, rewind to a marker
+		ScratchArena arena{ 64 };
+		void* a = arena.allocate(16, 8);
+		void* b = arena.allocate(16, 8);
+		arena.deallocate(b, 16, 8);
+		void* c = arena.allocate(16, 8);
+		if (b != c)
+			std::cout << "[FAIL] LIFO deallocation" << std::endl;
+
+		{
+			ScratchArena::Scope scope{ arena };
+			for (int i = 0; i < 32; i++)
+				static_cast<void>(arena.allocate(48, 16)); // grows out of the first chunk
+		}
+		std::size_t capacity = arena.Capacity();
+		void* d = arena.allocate(16, 8);
+		if (static_cast<std::byte*>(d) != static_cast<std::byte*>(a) + 32)
+			std::cout << "[FAIL] rewind" << std::endl;
+
+		{ // chunks are reused
+			ScratchArena::Scope scope{ arena };
+			for (int i = 0; i < 32; i++)
+				static_cast<void>(arena.allocate(48, 16));
+		}
+		if (arena.Capacity() != capacity)
+			std::cout << "[FAIL] reuse" << std::endl;
+	}
+
+	{ // results of DMInvoke/ADMInvoke are in the thread's result arena in a scope
+		ScratchScope scope;
+		if (ScratchScope::ResultResource() != &ScratchArena::ResultArena())
+			std::cout << "[FAIL] result resource" << std::endl;
+
+		for (int i = 0; i < 1000; i++) {
+			SharedObject w = ptr.ADMInvoke(StrIDRegistry::MetaID::operator_add, v);
+			if (w.As<Vec>().x != 2.f || w.As<Vec>().y != 4.f)
+				std::cout << "[FAIL] operator+" << std::endl;
+		}
+		std::cout << "result arena: " << ScratchArena::ResultArena().Capacity() << " bytes" << std::endl;
+	}
+	if (ScratchScope::ResultResource() != std::pmr::get_default_resource())
+		std::cout << "[FAIL] default resource out of scope" << std::endl;
+
+	{ // argument temporaries (float -> double) come from the thread's argument arena
+		for (int i = 0; i < 1000; i++) {
+			Vec w = ptr.Invoke<Vec>("Scale", 2.f);
+			if (w.x != 2.f || w.y != 4.f)
+				std::cout << "[FAIL] Scale" << std::endl;
+		}
+		std::cout << "argument arena: " << ScratchArena::ArgumentArena().Capacity() << " bytes" << std::endl;
+	}
+
+	// out of a scope, the results are owned as before
+	SharedObject w = ptr.DMInvoke(StrIDRegistry::MetaID::operator_add, v);
+	std::cout << "x: " << w.As<Vec>().x << ", y: " << w.As<Vec>().y << std::endl;
+
+	return 0;
+}
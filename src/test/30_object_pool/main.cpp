@@ -0,0 +1,83 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Message {
+	int id;
+	float payload[3];
+};
+
+struct Header {
+	int id;
+	int size;
+	long long timestamp;
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Message>();
+	ReflMngr::Instance().AddField<&Message::id>("id");
+	ReflMngr::Instance().RegisterType<Header>();
+	ReflMngr::Instance().AddField<&Header::id>("id");
+
+	ReflMngr::Instance().EnablePool(TypeID_of<Message>, 128);
+	ReflMngr::Instance().EnablePool(TypeID_of<Header>);
+
+	ObjectPool* pool = ReflMngr::Instance().GetPool(TypeID_of<Message>);
+	// same size class (16 bytes)
+	if (!pool || ReflMngr::Instance().GetPool(TypeID_of<Header>) != pool)
+		std::cout << "[FAIL] pool" << std::endl;
+
+	{ // a freed block is reused by the next New
+		ObjectPtr a = ReflMngr::Instance().New(TypeID_of<Message>);
+		void* ptr = a.GetPtr();
+		ReflMngr::Instance().Delete(a);
+		ObjectPtr b = ReflMngr::Instance().New(TypeID_of<Header>);
+		if (b.GetPtr() != ptr)
+			std::cout << "[FAIL] reuse" << std::endl;
+		ReflMngr::Instance().Delete(b);
+	}
+
+	{ // MakeShared and MNew (the pool is a memory resource)
+		SharedObject s = ReflMngr::Instance().MakeShared(TypeID_of<Message>);
+		s->RWVar("id") = 3;
+		ObjectPtr m = ReflMngr::Instance().MNew(TypeID_of<Message>, pool);
+		m.RWVar("id") = 4;
+		std::cout << "id: " << s->RVar("id") << ", " << m.RVar("id") << std::endl;
+		ReflMngr::Instance().MDelete(m, pool);
+	}
+
+	{ // produced on some threads, consumed on the others
+		constexpr std::size_t num_threads = 4;
+		constexpr std::size_t num_objects = 10000;
+		std::vector<std::vector<ObjectPtr>> objects(num_threads);
+
+		std::vector<std::thread> producers;
+		for (std::size_t i = 0; i < num_threads; i++) {
+			producers.emplace_back([&, i]() {
+				for (std::size_t k = 0; k < num_objects; k++)
+					objects[i].push_back(ReflMngr::Instance().New(TypeID_of<Message>));
+			});
+		}
+		for (auto& producer : producers)
+			producer.join();
+
+		std::vector<std::thread> consumers;
+		for (std::size_t i = 0; i < num_threads; i++) {
+			consumers.emplace_back([&, i]() {
+				for (ObjectPtr obj : objects[(i + 1) % num_threads])
+					ReflMngr::Instance().Delete(obj);
+			});
+		}
+		for (auto& consumer : consumers)
+			consumer.join();
+	}
+
+	std::cout << "slabs: " << pool->NumSlabs() << std::endl;
+
+	return 0;
+}
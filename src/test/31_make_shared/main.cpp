@@ -0,0 +1,72 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// counts the allocations of MakeShared
+class CountingResource : public std::pmr::memory_resource {
+public:
+	std::size_t num_allocations{ 0 };
+	std::size_t num_deallocations{ 0 };
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++num_allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		++num_deallocations;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+static int num_alive = 0;
+
+struct Message {
+	Message() { ++num_alive; }
+	Message(int id) : id{ id } { ++num_alive; }
+	~Message() { --num_alive; }
+	int id{ 0 };
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Message>();
+	ReflMngr::Instance().AddConstructor<Message, int>();
+	ReflMngr::Instance().AddField<&Message::id>("id");
+
+	CountingResource counter;
+	ReflMngr::Instance().SetObjectResource(&counter);
+
+	int id = 0;
+	{
+		SharedObject m = ReflMngr::Instance().MakeShared(TypeID_of<Message>, 3);
+		SharedObject copy = m;
+		id = m->RVar("id").As<int>();
+		if (num_alive != 1)
+			id = -1;
+	}
+
+	ReflMngr::Instance().SetObjectResource(std::pmr::new_delete_resource());
+
+	std::cout << "id: " << id << std::endl;
+
+	// the object and the control block
+	std::cout << "allocations: " << counter.num_allocations << std::endl;
+	if (counter.num_allocations != 1 || counter.num_deallocations != 1)
+		std::cout << "[FAIL] single allocation" << std::endl;
+	if (num_alive != 0)
+		std::cout << "[FAIL] dtor" << std::endl;
+
+	{ // pooled, the block holds the control block too
+		ReflMngr::Instance().EnablePool(TypeID_of<Message>);
+		SharedObject m = ReflMngr::Instance().MakeShared(TypeID_of<Message>, 4);
+		std::cout << "id: " << m->RVar("id") << std::endl;
+	}
+	if (num_alive != 0)
+		std::cout << "[FAIL] pooled dtor" << std::endl;
+
+	return 0;
+}
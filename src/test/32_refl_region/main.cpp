@@ -0,0 +1,48 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+static std::vector<int> destroyed;
+
+struct Node {
+	Node(int id) : id{ id } {}
+	~Node() { destroyed.push_back(id); }
+	int id;
+	std::string name;
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Node>();
+	ReflMngr::Instance().AddConstructor<Node, int>();
+	ReflMngr::Instance().AddField<&Node::id>("id");
+
+	{
+		ReflRegion region;
+		for (int i = 0; i < 100; i++) {
+			ObjectPtr node = region.New(TypeID_of<Node>, i);
+			if (!node || node.RVar("id").As<int>() != i)
+				std::cout << "[FAIL] New" << std::endl;
+		}
+		std::cout << "dtors: " << region.NumDestructors() << std::endl;
+
+		// reusable after Release()
+		region.Release();
+		if (destroyed.size() != 100 || destroyed.front() != 99 || destroyed.back() != 0)
+			std::cout << "[FAIL] reverse order" << std::endl;
+
+		region.New(TypeID_of<Node>, 100);
+		region.New(TypeID_of<Node>, 101);
+	}
+
+	if (destroyed.size() != 102 || destroyed.back() != 100)
+		std::cout << "[FAIL] region end" << std::endl;
+
+	std::cout << "destroyed: " << destroyed.size() << std::endl;
+
+	return 0;
+}
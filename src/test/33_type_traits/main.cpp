@@ -0,0 +1,100 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Vec {
+	float x;
+	float y;
+};
+
+// a null pointer to data member isn't all zero bytes (Itanium ABI)
+struct Axis {
+	float Vec::* member;
+};
+
+// trivially copyable, but not copy constructible
+struct Unique {
+	int id{ 0 };
+	Unique() = default;
+	Unique(const Unique&) = delete;
+	Unique(Unique&&) = default;
+	Unique& operator=(Unique&&) = default;
+};
+
+struct Named {
+	std::string name;
+	virtual ~Named() = default;
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Vec>();
+	ReflMngr::Instance().AddField<&Vec::x>("x");
+	ReflMngr::Instance().AddField<&Vec::y>("y");
+	ReflMngr::Instance().AddMemberMethod("Dot", [](const Vec& lhs, Vec rhs) {
+		return lhs.x * rhs.x + lhs.y * rhs.y;
+	});
+	ReflMngr::Instance().RegisterType<Named>();
+	ReflMngr::Instance().RegisterType<Axis>();
+	ReflMngr::Instance().RegisterType<Unique>();
+
+	const TypeTraits& vec_traits = ObjectPtr{ TypeID_of<Vec>, nullptr }.GetType()->traits;
+	const TypeTraits& named_traits = ObjectPtr{ TypeID_of<Named>, nullptr }.GetType()->traits;
+	std::cout
+		<< "Vec: " << vec_traits.is_trivially_copyable << vec_traits.is_trivially_destructible
+		<< vec_traits.is_trivially_default_constructible << vec_traits.is_standard_layout << vec_traits.is_polymorphic << std::endl
+		<< "Named: " << named_traits.is_trivially_copyable << named_traits.is_trivially_destructible
+		<< named_traits.is_trivially_default_constructible << named_traits.is_standard_layout << named_traits.is_polymorphic << std::endl
+		<< "zero initializable: " << vec_traits.is_zero_initializable << named_traits.is_zero_initializable << std::endl;
+
+	{ // T{} zeroes, T{const T&} copies
+		Vec v{ 3.f, 4.f };
+		ObjectPtr zero = ReflMngr::Instance().New(TypeID_of<Vec>);
+		ObjectPtr copy = ReflMngr::Instance().New(TypeID_of<Vec>, static_cast<const Vec&>(v));
+		if (zero.RVar("x").As<float>() != 0.f || copy.RVar("y").As<float>() != 4.f)
+			std::cout << "[FAIL] construct" << std::endl;
+		if (!ReflMngr::Instance().Destruct(copy))
+			std::cout << "[FAIL] destruct" << std::endl;
+		ReflMngr::Instance().Delete(zero);
+		ReflMngr::Instance().Delete(copy);
+	}
+
+	{ // T{} runs the registered ctor if T() isn't all zero bytes
+		ObjectPtr axis = ReflMngr::Instance().New(TypeID_of<Axis>);
+		if (!axis || axis.As<Axis>().member != nullptr)
+			std::cout << "[FAIL] member pointer" << std::endl;
+		ReflMngr::Instance().Delete(axis);
+	}
+
+	{ // no memcpy without a copy ctor, T{T&&} runs the registered move ctor
+		Unique u;
+		u.id = 2;
+		if (ReflMngr::Instance().New(TypeID_of<Unique>, static_cast<const Unique&>(u)))
+			std::cout << "[FAIL] deleted copy ctor" << std::endl;
+		ObjectPtr moved = ReflMngr::Instance().New(TypeID_of<Unique>, std::move(u));
+		if (!moved || moved.As<Unique>().id != 2)
+			std::cout << "[FAIL] move ctor" << std::endl;
+		ReflMngr::Instance().Delete(moved);
+	}
+
+	{ // the by-value argument is a memcpy'd temporary
+		Vec v{ 1.f, 2.f };
+		ObjectPtr ptr{ TypeID_of<Vec>, &v };
+		std::cout << "dot: " << ptr.Invoke<float>("Dot", v) << std::endl;
+	}
+
+	if (ReflMngr::Instance().GetDestructor(TypeID_of<Vec>) || !ReflMngr::Instance().GetDestructor(TypeID_of<Named>))
+		std::cout << "[FAIL] destructor" << std::endl;
+
+	{ // trivially destructible objects are not recorded
+		ReflRegion region;
+		region.New(TypeID_of<Vec>);
+		region.New(TypeID_of<Named>);
+		std::cout << "region dtors: " << region.NumDestructors() << std::endl;
+	}
+
+	return 0;
+}
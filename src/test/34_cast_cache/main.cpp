@@ -0,0 +1,96 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct A { float a{ 1.f }; };
+struct B { float b{ 2.f }; };
+struct C : A, B { float c{ 3.f }; };
+struct D : C { float d{ 4.f }; };
+
+struct V { float v{ 5.f }; };
+struct E : virtual V { float e{ 6.f }; };
+struct F : D, E { float f{ 7.f }; };
+
+// hand-built BaseInfo without an offset, its casts are always called
+struct G : A, B { float g{ 8.f }; };
+static int num_casts = 0;
+
+int main() {
+	ReflMngr::Instance().RegisterType<A>();
+	ReflMngr::Instance().RegisterType<B>();
+	ReflMngr::Instance().RegisterType<C>();
+	ReflMngr::Instance().RegisterType<D>();
+	ReflMngr::Instance().RegisterType<V>();
+	ReflMngr::Instance().RegisterType<E>();
+	ReflMngr::Instance().RegisterType<F>();
+	ReflMngr::Instance().AddBases<C, A, B>();
+	ReflMngr::Instance().AddBases<D, C>();
+	ReflMngr::Instance().AddBases<E, V>();
+	ReflMngr::Instance().AddBases<F, D, E>();
+	ReflMngr::Instance().RegisterType<G>();
+	ReflMngr::Instance().AddBase(TypeID_of<G>, TypeID_of<B>, BaseInfo{ {
+		[](const void* obj) -> const void* { ++num_casts; return static_cast<const B*>(static_cast<const G*>(obj)); },
+		[](const void* obj) -> const void* { ++num_casts; return static_cast<const G*>(static_cast<const B*>(obj)); },
+		nullptr
+	} });
+
+	F f;
+	G g;
+
+	for (int i = 0; i < 2; i++) {
+		if (i == 1)
+			ReflMngr::Instance().Freeze();
+
+		{ // non virtual path: one offset
+			ReflMngr::ReadGuard guard;
+			const CastPath& path = ReflMngr::Instance().ResolveCastPath(TypeID_of<F>, TypeID_of<B>);
+			if (!path || !path.unfolded_path.empty()
+				|| path.offset != static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(static_cast<const B*>(&f)) - reinterpret_cast<const std::uint8_t*>(&f)))
+				std::cout << "[FAIL] offset" << std::endl;
+			// memoized
+			if (&path != &ReflMngr::Instance().ResolveCastPath(TypeID_of<F>, TypeID_of<B>))
+				std::cout << "[FAIL] cache" << std::endl;
+		}
+
+		ObjectPtr b = ReflMngr::Instance().StaticCast_DerivedToBase(ObjectPtr{ TypeID_of<F>, &f }, TypeID_of<B>);
+		if (b.GetID() != TypeID_of<B> || b.GetPtr() != static_cast<B*>(&f))
+			std::cout << "[FAIL] derived to base" << std::endl;
+
+		ObjectPtr d = ReflMngr::Instance().StaticCast_BaseToDerived(b, TypeID_of<D>);
+		if (d.GetID() != TypeID_of<D> || d.GetPtr() != static_cast<D*>(&f))
+			std::cout << "[FAIL] base to derived" << std::endl;
+
+		// virtual base: the hops after the offset
+		ObjectPtr v = ReflMngr::Instance().StaticCast_DerivedToBase(ObjectPtr{ TypeID_of<F>, &f }, TypeID_of<V>);
+		if (v.GetID() != TypeID_of<V> || v.GetPtr() != static_cast<V*>(&f))
+			std::cout << "[FAIL] virtual derived to base" << std::endl;
+
+		if (ReflMngr::Instance().StaticCast_BaseToDerived(v, TypeID_of<E>).GetID())
+			std::cout << "[FAIL] virtual base to derived" << std::endl;
+
+		if (ReflMngr::Instance().StaticCast_DerivedToBase(ObjectPtr{ TypeID_of<A>, &f }, TypeID_of<B>).GetID())
+			std::cout << "[FAIL] unrelated" << std::endl;
+
+		{ // no offset: no folding, the casts are called
+			ReflMngr::ReadGuard guard;
+			const CastPath& path = ReflMngr::Instance().ResolveCastPath(TypeID_of<G>, TypeID_of<B>);
+			if (!path || path.offset != 0 || path.unfolded_path.size() != 1)
+				std::cout << "[FAIL] hand-built path" << std::endl;
+		}
+
+		num_casts = 0;
+		ObjectPtr gb = ReflMngr::Instance().StaticCast_DerivedToBase(ObjectPtr{ TypeID_of<G>, &g }, TypeID_of<B>);
+		ObjectPtr gd = ReflMngr::Instance().StaticCast_BaseToDerived(gb, TypeID_of<G>);
+		if (gb.GetPtr() != static_cast<B*>(&g) || gd.GetPtr() != &g || num_casts != 2)
+			std::cout << "[FAIL] hand-built casts" << std::endl;
+
+		std::cout << "B: " << b.RVar("b") << ", V: " << v.RVar("v") << std::endl;
+	}
+
+	ReflMngr::Instance().Unfreeze();
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Message { virtual ~Message() = default; int id{ 0 }; };
+struct Request : Message { int path{ 1 }; };
+struct Reply : Message { int code{ 2 }; };
+struct Get : Request { int query{ 3 }; };
+
+struct A { float a{ 0.f }; };
+struct B : virtual A { float b{ 0.f }; };
+struct C : virtual A { float c{ 0.f }; };
+struct D : B, C { float d{ 0.f }; };
+
+int main() {
+	ReflMngr::Instance().RegisterType<Message>();
+	ReflMngr::Instance().RegisterType<Request>();
+	ReflMngr::Instance().RegisterType<Reply>();
+	ReflMngr::Instance().RegisterType<Get>();
+	ReflMngr::Instance().AddBases<Request, Message>();
+	ReflMngr::Instance().AddBases<Reply, Message>();
+	ReflMngr::Instance().AddBases<Get, Request>();
+
+	ReflMngr::Instance().RegisterType<A>();
+	ReflMngr::Instance().RegisterType<B>();
+	ReflMngr::Instance().RegisterType<C>();
+	ReflMngr::Instance().RegisterType<D>();
+	ReflMngr::Instance().AddBases<B, A>();
+	ReflMngr::Instance().AddBases<C, A>();
+	ReflMngr::Instance().AddBases<D, B, C>();
+
+	Get get;
+	Reply reply;
+
+	for (int i = 0; i < 2; i++) {
+		if (i == 1)
+			ReflMngr::Instance().Freeze();
+
+		const bool expected =
+			ReflMngr::Instance().IsDerivedFrom(TypeID_of<Get>, TypeID_of<Message>)
+			&& ReflMngr::Instance().IsDerivedFrom(TypeID_of<Get>, TypeID_of<Request>)
+			&& ReflMngr::Instance().IsBaseOf(TypeID_of<Message>, TypeID_of<Reply>)
+			&& ReflMngr::Instance().IsDerivedFrom(TypeID_of<D>, TypeID_of<A>)
+			&& ReflMngr::Instance().IsDerivedFrom(TypeID_of<D>, TypeID_of<C>)
+			&& ReflMngr::Instance().IsDerivedFrom(TypeID_of<A>, TypeID_of<A>);
+		const bool unexpected =
+			ReflMngr::Instance().IsDerivedFrom(TypeID_of<Message>, TypeID_of<Get>)
+			|| ReflMngr::Instance().IsDerivedFrom(TypeID_of<Get>, TypeID_of<Reply>)
+			|| ReflMngr::Instance().IsDerivedFrom(TypeID_of<B>, TypeID_of<C>)
+			|| ReflMngr::Instance().IsDerivedFrom(TypeID_of<D>, TypeID_of<Message>)
+			|| ReflMngr::Instance().IsDerivedFrom(TypeID_of<Message>, TypeID_of<int>);
+		if (!expected || unexpected)
+			std::cout << "[FAIL] IsDerivedFrom" << std::endl;
+
+		ObjectPtr msg{ TypeID_of<Message>, static_cast<Message*>(&get) };
+		ObjectPtr to_get = ReflMngr::Instance().DynamicCast_BaseToDerived(msg, TypeID_of<Get>);
+		if (to_get.GetID() != TypeID_of<Get> || to_get.GetPtr() != &get)
+			std::cout << "[FAIL] downcast" << std::endl;
+
+		// a Reply isn't a Request
+		ObjectPtr other{ TypeID_of<Message>, static_cast<Message*>(&reply) };
+		if (ReflMngr::Instance().DynamicCast_BaseToDerived(other, TypeID_of<Request>).GetID())
+			std::cout << "[FAIL] checked downcast" << std::endl;
+
+		// unrelated, rejected by the hierarchy
+		if (ReflMngr::Instance().DynamicCast_BaseToDerived(msg, TypeID_of<D>).GetID())
+			std::cout << "[FAIL] unrelated downcast" << std::endl;
+
+		std::cout << "query: " << to_get.RVar("query") << std::endl;
+	}
+
+	ReflMngr::Instance().Unfreeze();
+
+	return 0;
+}
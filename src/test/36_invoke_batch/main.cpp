@@ -0,0 +1,93 @@
+#include <UDRefl/UDRefl.h>
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Tag { int tag{ 0 }; };
+
+struct Entity {
+	float x{ 0.f };
+
+	void Update(float dt) noexcept { x += dt; }
+	float Get() const noexcept { return x; }
+};
+
+struct Player : Tag, Entity {
+	int score{ 0 };
+};
+
+struct Rock {};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Tag>();
+	ReflMngr::Instance().RegisterType<Entity>();
+	ReflMngr::Instance().AddMethod<&Entity::Update>("Update");
+	ReflMngr::Instance().AddMethod<&Entity::Get>("Get");
+	ReflMngr::Instance().RegisterType<Player>();
+	ReflMngr::Instance().AddBases<Player, Tag, Entity>();
+	ReflMngr::Instance().RegisterType<Rock>();
+
+	std::vector<Entity> entities(1000);
+	std::vector<Player> players(10);
+	Rock rock;
+
+	{ // homogeneous: resolved once
+		std::vector<ObjectPtr> objs;
+		for (auto& entity : entities)
+			objs.emplace_back(TypeID_of<Entity>, &entity);
+
+		std::size_t n = ReflMngr::Instance().InvokeBatchArgs(objs, StrID{ "Update" }, 0.5f);
+		if (n != entities.size() || entities.back().x != 0.5f)
+			std::cout << "[FAIL] homogeneous" << std::endl;
+	}
+
+	{ // heterogeneous: Player casts to Entity, Rock has no Update
+		std::vector<ObjectPtr> objs;
+		for (std::size_t i = 0; i < players.size(); i++) {
+			objs.emplace_back(TypeID_of<Player>, &players[i]);
+			objs.emplace_back(TypeID_of<Entity>, &entities[i]);
+		}
+		objs.emplace_back(TypeID_of<Rock>, &rock);
+
+		std::size_t n = ReflMngr::Instance().InvokeBatchArgs(objs, StrID{ "Update" }, 1.f);
+		if (n != 2 * players.size() || players[3].x != 1.f || players[3].tag != 0 || entities[3].x != 1.5f)
+			std::cout << "[FAIL] heterogeneous" << std::endl;
+	}
+
+	{ // per object arguments and results
+		std::vector<ObjectPtr> objs;
+		std::vector<float> dts;
+		for (std::size_t i = 0; i < players.size(); i++) {
+			objs.emplace_back(TypeID_of<Player>, &players[i]);
+			dts.push_back(static_cast<float>(i));
+		}
+
+		std::vector<std::array<void*, 1>> args(players.size());
+		std::vector<ArgsBuffer> args_buffers;
+		for (std::size_t i = 0; i < players.size(); i++) {
+			args[i][0] = &dts[i];
+			args_buffers.push_back(args[i].data());
+		}
+		const TypeID argTypeIDs[] = { TypeID_of<float&> };
+		ReflMngr::Instance().InvokeBatch(objs, StrID{ "Update" }, argTypeIDs, args_buffers);
+
+		std::vector<float> gets(players.size());
+		std::vector<void*> result_buffers;
+		for (auto& get : gets)
+			result_buffers.push_back(&get);
+		std::vector<InvokeResult> results(players.size());
+		ReflMngr::Instance().InvokeBatch(objs, StrID{ "Get" }, {}, {}, result_buffers, results);
+
+		for (std::size_t i = 0; i < players.size(); i++) {
+			if (!results[i].success || results[i].resultID != TypeID_of<float> || gets[i] != 1.f + static_cast<float>(i))
+				std::cout << "[FAIL] results " << i << std::endl;
+		}
+		std::cout << "last: " << gets.back() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,49 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+int main() {
+	constexpr std::size_t N = 1027; // not a multiple of any vector width
+
+	std::vector<float> a(N), b(N), c(N);
+	for (std::size_t i = 0; i < N; i++) {
+		a[i] = static_cast<float>(i);
+		b[i] = 2.f;
+	}
+
+	// c = a * b
+	if (!ReflMngr::Instance().Apply<float>(StrIDRegistry::MetaID::operator_mul, a, b, c))
+		std::cout << "[FAIL] operator_mul" << std::endl;
+
+	// same as the reflected meta operator
+	for (std::size_t i = 0; i < N; i += 97) {
+		float expected = ObjectPtr{ TypeID_of<float>, &a[i] }.DMInvoke(StrIDRegistry::MetaID::operator_mul, b[i]).As<float>();
+		if (c[i] != expected)
+			std::cout << "[FAIL] element " << i << std::endl;
+	}
+
+	// a += c
+	ReflMngr::Instance().Apply<float>(StrIDRegistry::MetaID::operator_assign_add, a, c);
+	if (a.back() != 3.f * static_cast<float>(N - 1))
+		std::cout << "[FAIL] operator_assign_add" << std::endl;
+
+	// integers, no promotion
+	std::vector<std::uint8_t> x(N, 200), y(N, 100);
+	ReflMngr::Instance().Apply(StrIDRegistry::MetaID::operator_assign_add, TypeID_of<std::uint8_t>, N, x.data(), x.data(), y.data());
+	if (x[5] != static_cast<std::uint8_t>(300))
+		std::cout << "[FAIL] uint8" << std::endl;
+
+	std::vector<double> d(N, 1.);
+	if (ReflMngr::Instance().Apply<double>(StrIDRegistry::MetaID::operator_add, d, std::vector<double>(N - 1), d))
+		std::cout << "[FAIL] size mismatch" << std::endl;
+	if (ReflMngr::Instance().Apply(StrIDRegistry::MetaID::operator_mod, TypeID_of<double>, N, d.data(), d.data(), d.data()))
+		std::cout << "[FAIL] no kernel" << std::endl;
+
+	std::cout << "c[N-1]: " << c.back() << ", a[N-1]: " << a.back() << std::endl;
+
+	return 0;
+}
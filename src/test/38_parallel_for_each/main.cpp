@@ -0,0 +1,81 @@
+#include <UDRefl/UDRefl.h>
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Record {
+	int value{ 0 };
+	bool valid{ false };
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Record>();
+	ReflMngr::Instance().AddField<&Record::value>("value");
+	ReflMngr::Instance().AddField<&Record::valid>("valid");
+	ReflMngr::Instance().Freeze();
+
+	constexpr std::size_t N = 100000;
+	std::vector<Record> records(N);
+	std::vector<ObjectPtr> objs;
+	for (std::size_t i = 0; i < N; i++) {
+		records[i].value = static_cast<int>(i % 100);
+		objs.emplace_back(TypeID_of<Record>, &records[i]);
+	}
+
+	ThreadPool pool{ 4 };
+	ReflMngr::Instance().SetThreadPool(&pool);
+
+	{ // transformation, per worker scratch
+		std::vector<std::size_t> visited(pool.NumWorkers());
+		ReflMngr::Instance().ParallelForEach(objs, [&](std::size_t worker, ObjectPtr obj) {
+			obj.RWVar("valid") = obj.RVar("value").As<int>() % 2 == 0;
+			++visited[worker];
+		});
+
+		std::size_t total = 0;
+		for (std::size_t n : visited)
+			total += n;
+		if (total != N || !records[42].valid || records[43].valid)
+			std::cout << "[FAIL] ParallelForEach" << std::endl;
+	}
+
+	{ // deterministic reduction
+		std::size_t empty = ReflMngr::Instance().ParallelReduce(
+			std::span<const ObjectPtr>{},
+			std::size_t{ 0 },
+			[](std::size_t& acc, ObjectPtr) { ++acc; },
+			[](std::size_t lhs, std::size_t rhs) { return lhs + rhs; });
+		if (empty != 0)
+			std::cout << "[FAIL] empty" << std::endl;
+
+		auto sum = [&](std::size_t grain) {
+			return ReflMngr::Instance().ParallelReduce(
+				objs,
+				0ll,
+				[](long long& acc, ObjectPtr obj) {
+					if (obj.RVar("valid").As<bool>())
+						acc += obj.RVar("value").As<int>();
+				},
+				[](long long lhs, long long rhs) { return lhs + rhs; },
+				grain);
+		};
+		long long expected = 0;
+		for (const auto& record : records) {
+			if (record.valid)
+				expected += record.value;
+		}
+		if (sum(0) != expected || sum(7) != expected)
+			std::cout << "[FAIL] ParallelReduce" << std::endl;
+
+		std::cout << "sum: " << sum(0) << std::endl;
+	}
+
+	ReflMngr::Instance().SetThreadPool(nullptr);
+	ReflMngr::Instance().Unfreeze();
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+static int num_alive = 0;
+
+struct Payload {
+	Payload(int value) : value{ value } { ++num_alive; }
+	Payload(const Payload& other) : value{ other.value } { ++num_alive; }
+	Payload(Payload&& other) noexcept : value{ other.value } { ++num_alive; }
+	~Payload() { --num_alive; }
+	int value;
+};
+
+struct Pinned {
+	Pinned(int value) : value{ value } {}
+	Pinned(const Pinned&) = delete;
+	int value;
+};
+
+struct Counter {
+	int count{ 0 };
+
+	int Add(Payload p) { return count += p.value; }
+	int Scale(const Payload& p) const { return count * p.value; }
+	int Peek(const Pinned& p) const { return p.value; }
+	void Fail() const { throw std::runtime_error{ "Counter::Fail" }; }
+};
+
+// runs the calls on the caller's thread at Drain()
+class DeferredExecutor : public Executor {
+public:
+	void Execute(std::function<void()> task) override { tasks.push_back(std::move(task)); }
+
+	void Drain() {
+		for (auto& task : tasks)
+			task();
+		tasks.clear();
+	}
+
+	std::vector<std::function<void()>> tasks;
+};
+
+int main() {
+	ReflMngr::Instance().RegisterType<Payload>();
+	ReflMngr::Instance().AddConstructor<Payload, int>();
+	ReflMngr::Instance().RegisterType<Pinned>();
+	ReflMngr::Instance().RegisterType<Counter>();
+	ReflMngr::Instance().AddMethod<&Counter::Add>("Add");
+	ReflMngr::Instance().AddMethod<&Counter::Scale>("Scale");
+	ReflMngr::Instance().AddMethod<&Counter::Peek>("Peek");
+	ReflMngr::Instance().AddMethod<&Counter::Fail>("Fail");
+
+	Counter counter;
+	ObjectPtr obj{ TypeID_of<Counter>, &counter };
+
+	{ // ThreadPool::Default(), the temporary is copied before returning
+		auto add = ReflMngr::Instance().InvokeAsync(obj, StrID{ "Add" }, Payload{ 3 });
+		SharedObject rst = add.get();
+		if (!rst || rst->As<int>() != 3 || counter.count != 3)
+			std::cout << "[FAIL] Add" << std::endl;
+	}
+
+	{ // const & copied too
+		Payload p{ 2 };
+		auto scale = ReflMngr::Instance().InvokeAsync(ConstObjectPtr{ obj }, StrID{ "Scale" }, p);
+		p.value = 100;
+		if (scale.get()->As<int>() != 6)
+			std::cout << "[FAIL] Scale" << std::endl;
+	}
+
+	{ // const & of an uncopyable type, fails rather than binding the caller's object
+		Pinned p{ 5 };
+		if (ReflMngr::Instance().InvokeAsync(ConstObjectPtr{ obj }, StrID{ "Peek" }, p).get())
+			std::cout << "[FAIL] Peek" << std::endl;
+	}
+
+	{ // exception of the method, unresolved method
+		auto fail = ReflMngr::Instance().InvokeAsync(obj, StrID{ "Fail" });
+		try {
+			fail.get();
+			std::cout << "[FAIL] Fail" << std::endl;
+		}
+		catch (const std::runtime_error&) {}
+
+		if (ReflMngr::Instance().InvokeAsync(obj, StrID{ "Missing" }).get())
+			std::cout << "[FAIL] Missing" << std::endl;
+	}
+
+	{ // pluggable executor
+		DeferredExecutor executor;
+		ReflMngr::Instance().SetExecutor(&executor);
+
+		auto add = ReflMngr::Instance().InvokeAsync(obj, StrID{ "Add" }, Payload{ 4 });
+		if (executor.tasks.size() != 1 || counter.count != 3)
+			std::cout << "[FAIL] deferred" << std::endl;
+		executor.Drain();
+		if (add.get()->As<int>() != 7)
+			std::cout << "[FAIL] Drain" << std::endl;
+
+		ReflMngr::Instance().SetExecutor(nullptr);
+	}
+
+	if (num_alive != 0)
+		std::cout << "[FAIL] copies: " << num_alive << std::endl;
+
+	std::cout << "count: " << counter.count << std::endl;
+
+	return 0;
+}
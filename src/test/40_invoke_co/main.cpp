@@ -0,0 +1,111 @@
+#include <UDRefl/UDRefl.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+// a pending I/O, resumed by Complete()
+struct Request {
+	std::coroutine_handle<> waiting;
+	int data{ 0 };
+
+	auto Wait() {
+		struct Awaiter {
+			Request& request;
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> handle) noexcept { request.waiting = handle; }
+			int await_resume() const noexcept { return request.data; }
+		};
+		return Awaiter{ *this };
+	}
+
+	void Complete(int value) {
+		data = value;
+		std::exchange(waiting, nullptr).resume();
+	}
+};
+
+struct Service {
+	Request* request{ nullptr };
+
+	Task<std::string> Read(int offset) const {
+		int data = co_await request->Wait();
+		co_return std::to_string(offset + data);
+	}
+
+	// reads text after resuming, the caller's argument is gone by then
+	Task<std::size_t> Length(const std::string& text) const {
+		co_await request->Wait();
+		co_return text.size();
+	}
+
+	Task<> Close() {
+		co_await request->Wait();
+		throw std::runtime_error{ "Service::Close" };
+	}
+
+	int Ping() const { return 1; }
+};
+
+Task<> Handle(ObjectPtr service, std::string& out, bool& failed) {
+	SharedObject text = co_await ReflMngr::Instance().InvokeCo(service, StrID{ "Read" }, 40);
+	out = text->As<std::string>();
+
+	Task<SharedObject> length_task = ReflMngr::Instance().InvokeCo(service, StrID{ "Length" }, std::string{ "text" });
+	SharedObject length = co_await length_task;
+	if (length->As<std::size_t>() != 4)
+		out.clear();
+
+	SharedObject ping = co_await ReflMngr::Instance().InvokeCo(service, StrID{ "Ping" });
+	if (ping->As<int>() != 1)
+		out.clear();
+
+	SharedObject missing = co_await ReflMngr::Instance().InvokeCo(service, StrID{ "Missing" });
+	if (missing)
+		out.clear();
+
+	try {
+		co_await ReflMngr::Instance().InvokeCo(service, StrID{ "Close" });
+	}
+	catch (const std::runtime_error&) {
+		failed = true;
+	}
+}
+
+int main() {
+	ReflMngr::Instance().RegisterType<std::string>();
+	ReflMngr::Instance().RegisterType<Service>();
+	ReflMngr::Instance().AddMethod<&Service::Read>("Read");
+	ReflMngr::Instance().AddMethod<&Service::Length>("Length");
+	ReflMngr::Instance().AddMethod<&Service::Close>("Close");
+	ReflMngr::Instance().AddMethod<&Service::Ping>("Ping");
+
+	if (!ReflMngr::Instance().IsDerivedFrom(TypeID_of<Task<std::string>>, TypeID_of<TaskBase>))
+		std::cout << "[FAIL] TaskBase" << std::endl;
+
+	Request request;
+	Service service{ &request };
+	std::string out;
+	bool failed = false;
+
+	Task<> handler = Handle(ObjectPtr{ TypeID_of<Service>, &service }, out, failed);
+	handler.Start();
+
+	// no thread is blocked while the requests are pending
+	if (handler.IsReady() || !request.waiting)
+		std::cout << "[FAIL] suspended" << std::endl;
+
+	request.Complete(2); // Read
+	request.Complete(0); // Length
+	request.Complete(0); // Close
+
+	if (!handler.IsReady() || out != "42" || !failed)
+		std::cout << "[FAIL] InvokeCo" << std::endl;
+
+	std::cout << "Read: " << out << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include <UDRefl/UDRefl.h>
+
+#include <array>
+#include <iostream>
+
+using namespace Ubpa;
+using namespace Ubpa::UDRefl;
+
+struct Data {
+	float value{ 0.f };
+};
+
+using Shape = TypeIDRegistry::TypeShape;
+
+// every field against the std traits of T
+template<typename T>
+void CheckShape(const char* label) {
+	using Referee = std::remove_reference_t<T>;
+	using Raw = std::remove_cvref_t<T>;
+
+	ReflMngr::Instance().tregistry.Register<T>();
+	const Shape* shape = ReflMngr::Instance().tregistry.GetShape(TypeID_of<T>);
+	if (!shape) {
+		std::cout << "[FAIL] " << label << ": no shape" << std::endl;
+		return;
+	}
+
+	const Shape::Reference reference = std::is_lvalue_reference_v<T> ? Shape::Reference::LValue
+		: std::is_rvalue_reference_v<T> ? Shape::Reference::RValue
+		: Shape::Reference::None;
+
+	if (shape->reference != reference
+		|| shape->IsReference() != std::is_reference_v<T>
+		|| shape->IsLValueReference() != std::is_lvalue_reference_v<T>
+		|| shape->IsRValueReference() != std::is_rvalue_reference_v<T>)
+		std::cout << "[FAIL] " << label << ": reference" << std::endl;
+	if (shape->is_const != std::is_const_v<Referee>)
+		std::cout << "[FAIL] " << label << ": is_const" << std::endl;
+	if (shape->is_pointer != std::is_pointer_v<Referee>)
+		std::cout << "[FAIL] " << label << ": is_pointer" << std::endl;
+	if (shape->referee != TypeID_of<Referee> || shape->raw != TypeID_of<Raw>)
+		std::cout << "[FAIL] " << label << ": referee/raw" << std::endl;
+	if (shape->lref != TypeID_of<Raw&> || shape->clref != TypeID_of<const Raw&>
+		|| shape->rref != TypeID_of<Raw&&> || shape->crref != TypeID_of<const Raw&&>)
+		std::cout << "[FAIL] " << label << ": variants" << std::endl;
+}
+
+// the name parsing of GetDereferenceProperty/Dereference before the shapes
+template<typename T>
+void CheckDereference(const char* label) {
+	std::string_view name = type_name<T>();
+
+	DereferenceProperty property = DereferenceProperty::NotReference;
+	TypeID dereferenced = TypeID_of<T>;
+	if (type_name_is_reference(name)) {
+		auto unref_name = type_name_remove_reference(name);
+		property = type_name_is_const(unref_name) ? DereferenceProperty::Const : DereferenceProperty::Variable;
+		dereferenced = TypeID{ type_name_remove_cv(unref_name) };
+	}
+
+	if (ReflMngr::Instance().GetDereferenceProperty(TypeID_of<T>) != property
+		|| ReflMngr::Instance().Dereference(TypeID_of<T>) != dereferenced)
+		std::cout << "[FAIL] " << label << ": dereference" << std::endl;
+}
+
+int main() {
+	ReflMngr::Instance().RegisterType<Data>();
+
+	CheckShape<Data>("T");
+	CheckShape<Data&>("T&");
+	CheckShape<const Data&>("const T&");
+	CheckShape<Data&&>("T&&");
+	CheckShape<const Data&&>("const T&&");
+	CheckShape<Data*>("T*");
+	CheckShape<const Data*>("const T*");
+	CheckShape<const Data*&>("const T*&");
+
+	CheckDereference<Data>("T");
+	CheckDereference<Data&>("T&");
+	CheckDereference<const Data&>("const T&");
+	CheckDereference<Data&&>("T&&");
+	CheckDereference<Data*>("T*");
+
+	{ // IsCompatible, param <- arg, as the name parsing decided it (Data is copy constructible)
+		const std::array params = { TypeID_of<Data>, TypeID_of<Data&>, TypeID_of<const Data&>, TypeID_of<Data&&>, TypeID_of<Data*> };
+		const std::array args = { TypeID_of<Data>, TypeID_of<Data&>, TypeID_of<const Data&>, TypeID_of<Data&&>, TypeID_of<const Data&&>, TypeID_of<Data*> };
+		constexpr bool expected[5][6] = {
+			//  T      T&     const T&  T&&    const T&&  T*
+			{ true,  true,  true,     true,  true,      false }, // T        <- T{arg}
+			{ false, true,  false,    false, false,     false }, // T&       only binds T&
+			{ true,  true,  true,     true,  true,      false }, // const T&
+			{ true,  true,  true,     true,  true,      false }, // T&&      <- T{arg}
+			{ false, false, false,    false, false,     true  }, // T*
+		};
+		for (std::size_t i = 0; i < params.size(); i++) {
+			for (std::size_t j = 0; j < args.size(); j++) {
+				if (ReflMngr::Instance().IsCompatible(std::span{ &params[i], 1 }, std::span{ &args[j], 1 }) != expected[i][j])
+					std::cout << "[FAIL] IsCompatible " << i << " <- " << j << std::endl;
+			}
+		}
+	}
+
+	std::cout << "done" << std::endl;
+
+	return 0;
+}